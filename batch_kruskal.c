@@ -0,0 +1,507 @@
+//
+//  batch_kruskal.c
+//  kruskal-maze-generation-c
+//
+//  Created by Ezzat Chamudi on 10/19/26.
+//  Copyright © 2026 Ezzat Chamudi. All rights reserved.
+//  License: Apache-2.0
+//
+
+#include "batch_kruskal.h"
+
+#include "randomized_kruskal.h"
+
+// Lockstep generation of many small mazes, one per vector lane. Every step
+// each lane draws a cell, the 3x3 room windows are gathered for all lanes at
+// once and the legal-direction tests run as lane-wide compares. Selection and
+// linking are per lane; the room merge is a lane-wide relabel of the grid.
+// Finished lanes are restarted with the next maze, so lanes never idle
+// until the batch runs out.
+//
+// Selection follows randomized_kruskal_walls(): random cell, retry without
+// legal moves, letter-S first, otherwise a random legal direction. Each lane
+// has its own xorshift32 stream, so results follow the same distribution but
+// not the same mazes as the serial generator.
+
+#if defined(__AVX512F__)
+
+#include <immintrin.h>
+
+#define LANES 16
+typedef __m512i lanes_t;
+
+static inline lanes_t lanes_set1(int value) { return _mm512_set1_epi32(value); }
+static inline lanes_t lanes_load(const int *p) { return _mm512_loadu_si512((const void *)p); }
+static inline void lanes_store(int *p, lanes_t a) { _mm512_storeu_si512((void *)p, a); }
+static inline lanes_t lanes_add(lanes_t a, lanes_t b) { return _mm512_add_epi32(a, b); }
+static inline lanes_t lanes_mul(lanes_t a, lanes_t b) { return _mm512_mullo_epi32(a, b); }
+static inline lanes_t lanes_and(lanes_t a, lanes_t b) { return _mm512_and_si512(a, b); }
+static inline lanes_t lanes_or(lanes_t a, lanes_t b) { return _mm512_or_si512(a, b); }
+static inline lanes_t lanes_xor(lanes_t a, lanes_t b) { return _mm512_xor_si512(a, b); }
+static inline lanes_t lanes_andnot(lanes_t a, lanes_t b) { return _mm512_andnot_si512(a, b); }
+static inline lanes_t lanes_shl(lanes_t a, int n) { return _mm512_sll_epi32(a, _mm_cvtsi32_si128(n)); }
+static inline lanes_t lanes_shr(lanes_t a, int n) { return _mm512_srl_epi32(a, _mm_cvtsi32_si128(n)); }
+static inline lanes_t lanes_eq(lanes_t a, lanes_t b) { return _mm512_maskz_mov_epi32(_mm512_cmpeq_epi32_mask(a, b), _mm512_set1_epi32(-1)); }
+static inline lanes_t lanes_blend(lanes_t a, lanes_t b, lanes_t mask) { return _mm512_mask_blend_epi32(_mm512_test_epi32_mask(mask, mask), a, b); }
+static inline lanes_t lanes_gather(const int *base, lanes_t index) { return _mm512_i32gather_epi32(index, (const void *)base, 4); }
+static inline bool lanes_any(lanes_t mask) { return _mm512_test_epi32_mask(mask, mask) != 0; }
+static inline lanes_t lanes_ids(void) { return _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15); }
+
+#define LANES_BACKEND "avx512"
+
+#elif defined(__AVX2__)
+
+#include <immintrin.h>
+
+#define LANES 8
+typedef __m256i lanes_t;
+
+static inline lanes_t lanes_set1(int value) { return _mm256_set1_epi32(value); }
+static inline lanes_t lanes_load(const int *p) { return _mm256_loadu_si256((const __m256i *)p); }
+static inline void lanes_store(int *p, lanes_t a) { _mm256_storeu_si256((__m256i *)p, a); }
+static inline lanes_t lanes_add(lanes_t a, lanes_t b) { return _mm256_add_epi32(a, b); }
+static inline lanes_t lanes_mul(lanes_t a, lanes_t b) { return _mm256_mullo_epi32(a, b); }
+static inline lanes_t lanes_and(lanes_t a, lanes_t b) { return _mm256_and_si256(a, b); }
+static inline lanes_t lanes_or(lanes_t a, lanes_t b) { return _mm256_or_si256(a, b); }
+static inline lanes_t lanes_xor(lanes_t a, lanes_t b) { return _mm256_xor_si256(a, b); }
+static inline lanes_t lanes_andnot(lanes_t a, lanes_t b) { return _mm256_andnot_si256(a, b); }
+static inline lanes_t lanes_shl(lanes_t a, int n) { return _mm256_sll_epi32(a, _mm_cvtsi32_si128(n)); }
+static inline lanes_t lanes_shr(lanes_t a, int n) { return _mm256_srl_epi32(a, _mm_cvtsi32_si128(n)); }
+static inline lanes_t lanes_eq(lanes_t a, lanes_t b) { return _mm256_cmpeq_epi32(a, b); }
+static inline lanes_t lanes_blend(lanes_t a, lanes_t b, lanes_t mask) { return _mm256_blendv_epi8(a, b, mask); }
+static inline lanes_t lanes_gather(const int *base, lanes_t index) { return _mm256_i32gather_epi32(base, index, 4); }
+static inline bool lanes_any(lanes_t mask) { return !_mm256_testz_si256(mask, mask); }
+static inline lanes_t lanes_ids(void) { return _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7); }
+
+#define LANES_BACKEND "avx2"
+
+#else
+
+// Same lockstep kernel on plain arrays; compilers vectorize some of it
+#define LANES 8
+typedef struct { int v[LANES]; } lanes_t;
+
+#define LANES_MAP(expression) \
+    lanes_t out; \
+    for (int i = 0; i < LANES; i++) out.v[i] = (expression); \
+    return out
+
+static inline lanes_t lanes_set1(int value) { LANES_MAP(value); }
+static inline lanes_t lanes_load(const int *p) { LANES_MAP(p[i]); }
+static inline void lanes_store(int *p, lanes_t a) { for (int i = 0; i < LANES; i++) p[i] = a.v[i]; }
+static inline lanes_t lanes_add(lanes_t a, lanes_t b) { LANES_MAP((int)((unsigned int)a.v[i] + (unsigned int)b.v[i])); }
+static inline lanes_t lanes_mul(lanes_t a, lanes_t b) { LANES_MAP((int)((unsigned int)a.v[i] * (unsigned int)b.v[i])); }
+static inline lanes_t lanes_and(lanes_t a, lanes_t b) { LANES_MAP(a.v[i] & b.v[i]); }
+static inline lanes_t lanes_or(lanes_t a, lanes_t b) { LANES_MAP(a.v[i] | b.v[i]); }
+static inline lanes_t lanes_xor(lanes_t a, lanes_t b) { LANES_MAP(a.v[i] ^ b.v[i]); }
+static inline lanes_t lanes_andnot(lanes_t a, lanes_t b) { LANES_MAP(~a.v[i] & b.v[i]); }
+static inline lanes_t lanes_shl(lanes_t a, int n) { LANES_MAP((int)((unsigned int)a.v[i] << n)); }
+static inline lanes_t lanes_shr(lanes_t a, int n) { LANES_MAP((int)((unsigned int)a.v[i] >> n)); }
+static inline lanes_t lanes_eq(lanes_t a, lanes_t b) { LANES_MAP(a.v[i] == b.v[i] ? -1 : 0); }
+static inline lanes_t lanes_blend(lanes_t a, lanes_t b, lanes_t mask) { LANES_MAP(mask.v[i] ? b.v[i] : a.v[i]); }
+static inline lanes_t lanes_gather(const int *base, lanes_t index) { LANES_MAP(base[index.v[i]]); }
+static inline lanes_t lanes_ids(void) { LANES_MAP(i); }
+
+static inline bool lanes_any(lanes_t mask)
+{
+    for (int i = 0; i < LANES; i++)
+    {
+        if (mask.v[i])
+            return true;
+    }
+    return false;
+}
+
+#define LANES_BACKEND "scalar"
+
+#endif
+
+const char *batch_kruskal_backend(void)
+{
+    return LANES_BACKEND;
+}
+
+int batch_kruskal_lanes(void)
+{
+    return LANES;
+}
+
+static inline lanes_t lanes_neq(lanes_t a, lanes_t b)
+{
+    return lanes_xor(lanes_eq(a, b), lanes_set1(-1));
+}
+
+static inline lanes_t lanes_unique_3(lanes_t a, lanes_t b, lanes_t c)
+{
+    return lanes_and(lanes_and(lanes_neq(a, b), lanes_neq(a, c)), lanes_neq(b, c));
+}
+
+static inline lanes_t lanes_next(lanes_t *state)
+{
+    // xorshift32 per lane, multiplied so the high bits mix well
+    lanes_t s = *state;
+    s = lanes_xor(s, lanes_shl(s, 13));
+    s = lanes_xor(s, lanes_shr(s, 17));
+    s = lanes_xor(s, lanes_shl(s, 5));
+    *state = s;
+    return lanes_mul(s, lanes_set1((int)0x9E3779BBu));
+}
+
+static inline lanes_t lanes_range(lanes_t random, int n)
+{
+    // High 16 bits times n; n is at most BATCH_MAX_SIZE
+    return lanes_shr(lanes_mul(lanes_shr(random, 16), lanes_set1(n)), 16);
+}
+
+static inline int lane_range(int random, int n)
+{
+    return (int)((((unsigned int)random >> 16) * (unsigned int)n) >> 16);
+}
+
+// Window slot of (dx, dy) is (dx + 1) * 3 + (dy + 1), as in rooms[dx + 1][dy + 1]
+#define WINDOW_TOP_LEFT 0
+#define WINDOW_LEFT 1
+#define WINDOW_BOTTOM_LEFT 2
+#define WINDOW_TOP 3
+#define WINDOW_MID 4
+#define WINDOW_BOTTOM 5
+#define WINDOW_TOP_RIGHT 6
+#define WINDOW_RIGHT 7
+#define WINDOW_BOTTOM_RIGHT 8
+
+struct batch_lanes {
+    int size;
+    int padded;
+    int total_padded;
+    int *labels;
+    unsigned char *degrees;
+
+    int rooms[LANES];
+    int passes[LANES];
+    int failed_passes[LANES];
+    int fail_streak[LANES];
+    bool active[LANES];
+};
+
+static void reset_lane(struct batch_lanes *lanes, int lane)
+{
+    int size = lanes->size;
+    int padded = lanes->padded;
+
+    for (int cell = 0; cell < lanes->total_padded; cell++)
+    {
+        int x = cell / padded - 1;
+        int y = cell % padded - 1;
+        bool inside = x >= 0 && x < size && y >= 0 && y < size;
+
+        // Border cells never match a room; legality checks the border first
+        lanes->labels[cell * LANES + lane] = inside ? cell : -1;
+        lanes->degrees[cell * LANES + lane] = 0;
+    }
+
+    lanes->rooms[lane] = size * size;
+    lanes->passes[lane] = 0;
+    lanes->failed_passes[lane] = 0;
+    lanes->fail_streak[lane] = 0;
+    lanes->active[lane] = true;
+}
+
+static void finish_lane(struct batch_lanes *lanes, int lane, struct batch_totals *totals)
+{
+    int size = lanes->size;
+    int padded = lanes->padded;
+
+    for (int x = 0; x < size; x++)
+    {
+        for (int y = 0; y < size; y++)
+        {
+            switch (lanes->degrees[((x + 1) * padded + y + 1) * LANES + lane])
+            {
+            case 1:
+                totals->total_deg1_nodes++;
+                break;
+            case 2:
+                totals->total_deg2_nodes++;
+                break;
+            case 3:
+                totals->total_deg3_nodes++;
+                break;
+            case 4:
+                totals->total_deg4_nodes++;
+                break;
+            default:
+                printf("ERROR: Bad degree.");
+                exit(1);
+            }
+        }
+    }
+
+    totals->total_mazes++;
+    totals->total_passes += lanes->passes[lane];
+    totals->total_failed_passes += lanes->failed_passes[lane];
+}
+
+static lanes_t legal_bits(lanes_t window[9], lanes_t x, lanes_t y, int size, unsigned int direction_options)
+{
+    lanes_t zero = lanes_set1(0);
+    lanes_t top_border = lanes_eq(y, zero);
+    lanes_t bottom_border = lanes_eq(y, lanes_set1(size - 1));
+    lanes_t left_border = lanes_eq(x, zero);
+    lanes_t right_border = lanes_eq(x, lanes_set1(size - 1));
+
+    lanes_t mid = window[WINDOW_MID];
+    lanes_t bits = zero;
+
+#define ADD_DIRECTION(direction, borders, legal) \
+    bits = lanes_or(bits, lanes_and(lanes_andnot(borders, legal), lanes_set1(1 << (direction))))
+
+    if (direction_options & ENABLE_STANDARD)
+    {
+        ADD_DIRECTION(TOP, top_border, lanes_neq(mid, window[WINDOW_TOP]));
+        ADD_DIRECTION(RIGHT, right_border, lanes_neq(mid, window[WINDOW_RIGHT]));
+        ADD_DIRECTION(BOTTOM, bottom_border, lanes_neq(mid, window[WINDOW_BOTTOM]));
+        ADD_DIRECTION(LEFT, left_border, lanes_neq(mid, window[WINDOW_LEFT]));
+    }
+
+    if (direction_options & ENABLE_DIAGONAL)
+    {
+        lanes_t top_left = lanes_or(top_border, left_border);
+        lanes_t top_right = lanes_or(top_border, right_border);
+        lanes_t bottom_right = lanes_or(bottom_border, right_border);
+        lanes_t bottom_left = lanes_or(bottom_border, left_border);
+
+        ADD_DIRECTION(TOP_LEFT, top_left, lanes_unique_3(mid, window[WINDOW_TOP], window[WINDOW_TOP_LEFT]));
+        ADD_DIRECTION(TOP_RIGHT, top_right, lanes_unique_3(mid, window[WINDOW_TOP], window[WINDOW_TOP_RIGHT]));
+        ADD_DIRECTION(RIGHT_TOP, top_right, lanes_unique_3(mid, window[WINDOW_RIGHT], window[WINDOW_TOP_RIGHT]));
+        ADD_DIRECTION(RIGHT_BOTTOM, bottom_right, lanes_unique_3(mid, window[WINDOW_RIGHT], window[WINDOW_BOTTOM_RIGHT]));
+        ADD_DIRECTION(BOTTOM_RIGHT, bottom_right, lanes_unique_3(mid, window[WINDOW_BOTTOM], window[WINDOW_BOTTOM_RIGHT]));
+        ADD_DIRECTION(BOTTOM_LEFT, bottom_left, lanes_unique_3(mid, window[WINDOW_BOTTOM], window[WINDOW_BOTTOM_LEFT]));
+        ADD_DIRECTION(LEFT_BOTTOM, bottom_left, lanes_unique_3(mid, window[WINDOW_LEFT], window[WINDOW_BOTTOM_LEFT]));
+        ADD_DIRECTION(LEFT_TOP, top_left, lanes_unique_3(mid, window[WINDOW_LEFT], window[WINDOW_TOP_LEFT]));
+    }
+
+    if (direction_options & ENABLE_LETTERS)
+    {
+        lanes_t near_border = lanes_or(lanes_or(top_border, bottom_border), lanes_or(left_border, right_border));
+
+        lanes_t unique = lanes_set1(-1);
+        for (int i = 0; i < 9; i++)
+        {
+            for (int j = i + 1; j < 9; j++)
+                unique = lanes_and(unique, lanes_neq(window[i], window[j]));
+        }
+
+        ADD_DIRECTION(LETTER_S, near_border, unique);
+    }
+
+#undef ADD_DIRECTION
+
+    return bits;
+}
+
+void batch_kruskal(int size, unsigned int direction_options, long long total_mazes, unsigned long long seed, struct batch_totals *totals)
+{
+    if (size < 2 || size > BATCH_MAX_SIZE)
+    {
+        printf("ERROR: Batch size must be between 2 and %d.\n", BATCH_MAX_SIZE);
+        exit(1);
+    }
+
+    struct batch_lanes lanes;
+    lanes.size = size;
+    lanes.padded = size + 2;
+    lanes.total_padded = lanes.padded * lanes.padded;
+    lanes.labels = (int *)calloc((size_t)lanes.total_padded * LANES, sizeof(int));
+    lanes.degrees = (unsigned char *)calloc((size_t)lanes.total_padded * LANES, sizeof(unsigned char));
+
+    const long long max_fail_streak = (long long)size * size * 10;
+    const int padded = lanes.padded;
+
+    // Offsets of the window slots in lane-interleaved storage
+    int offsets[9];
+    for (int dx = -1; dx <= 1; dx++)
+    {
+        for (int dy = -1; dy <= 1; dy++)
+            offsets[(dx + 1) * 3 + (dy + 1)] = (dx * padded + dy) * LANES;
+    }
+
+    int seeds[LANES];
+    for (int lane = 0; lane < LANES; lane++)
+    {
+        // xorshift32 must not start at zero
+        seeds[lane] = (int)(rng_derive(seed, lane) | 1);
+    }
+    lanes_t state = lanes_load(seeds);
+
+    memset(totals, 0, sizeof(struct batch_totals));
+
+    long long started = 0;
+    int total_active = 0;
+    for (int lane = 0; lane < LANES; lane++)
+    {
+        if (started < total_mazes)
+        {
+            reset_lane(&lanes, lane);
+            started++;
+            total_active++;
+        }
+        else
+        {
+            lanes.active[lane] = false;
+        }
+    }
+
+    const lanes_t ids = lanes_ids();
+    const lanes_t one = lanes_set1(1);
+
+    int xs[LANES], ys[LANES], picks[LANES], bits[LANES];
+    int window[9][LANES];
+    int sources[8][LANES];
+    int targets[LANES];
+
+    while (total_active > 0)
+    {
+        lanes_t x = lanes_range(lanes_next(&state), size);
+        lanes_t y = lanes_range(lanes_next(&state), size);
+        lanes_t pick = lanes_next(&state);
+
+        lanes_t cell = lanes_add(lanes_mul(lanes_add(x, one), lanes_set1(padded)), lanes_add(y, one));
+        lanes_t base = lanes_add(lanes_mul(cell, lanes_set1(LANES)), ids);
+
+        lanes_t rooms[9];
+        for (int i = 0; i < 9; i++)
+        {
+            rooms[i] = lanes_gather(lanes.labels, lanes_add(base, lanes_set1(offsets[i])));
+            lanes_store(window[i], rooms[i]);
+        }
+
+        lanes_store(bits, legal_bits(rooms, x, y, size, direction_options));
+        lanes_store(xs, x);
+        lanes_store(ys, y);
+        lanes_store(picks, pick);
+
+        // Select, link and queue merges lane by lane
+        int total_slots = 0;
+
+        for (int lane = 0; lane < LANES; lane++)
+        {
+            for (int slot = 0; slot < 8; slot++)
+                sources[slot][lane] = -2;
+            targets[lane] = -2;
+
+            if (!lanes.active[lane])
+                continue;
+
+            lanes.passes[lane]++;
+
+            int legal = bits[lane];
+            if (legal == 0)
+            {
+                lanes.failed_passes[lane]++;
+                lanes.fail_streak[lane]++;
+
+                if (lanes.fail_streak[lane] > max_fail_streak)
+                {
+                    printf("ERROR: Too much fail streak. Can't combine all rooms using legal directions.\n");
+                    exit(1);
+                }
+
+                continue;
+            }
+            lanes.fail_streak[lane] = 0;
+
+            int selected_direction;
+            if (legal & (1 << LETTER_S))
+            {
+                selected_direction = LETTER_S;
+            }
+            else
+            {
+                int remaining = lane_range(picks[lane], __builtin_popcount(legal));
+                while (remaining--)
+                    legal &= legal - 1;
+                selected_direction = __builtin_ctz(legal);
+            }
+
+            struct coordinate node_mid;
+            node_mid.x = xs[lane];
+            node_mid.y = ys[lane];
+
+            struct coordinate selected_nodes[9];
+            int total_selected_nodes = direction_nodes(selected_nodes, node_mid, selected_direction);
+
+            int cells[9];
+            for (int i = 0; i < total_selected_nodes; i++)
+            {
+                int dx = (int)selected_nodes[i].x - (int)node_mid.x;
+                int dy = (int)selected_nodes[i].y - (int)node_mid.y;
+                int label = window[(dx + 1) * 3 + (dy + 1)][lane];
+                cells[i] = (selected_nodes[i].x + 1) * padded + selected_nodes[i].y + 1;
+
+                // Everything joins the room of the first node
+                if (i == 0)
+                    targets[lane] = label;
+                else
+                    sources[i - 1][lane] = label;
+            }
+
+            // Same passages as link_direction_nodes(), counted as degrees
+            static const int s_links[8][2] = {{0, 1}, {1, 2}, {3, 4}, {4, 5}, {6, 7}, {7, 8}, {0, 3}, {5, 8}};
+            static const int line_links[2][2] = {{0, 1}, {1, 2}};
+            const int (*links)[2] = selected_direction == LETTER_S ? s_links : line_links;
+            int total_links = total_selected_nodes == 9 ? 8 : total_selected_nodes - 1;
+
+            for (int i = 0; i < total_links; i++)
+            {
+                lanes.degrees[cells[links[i][0]] * LANES + lane]++;
+                lanes.degrees[cells[links[i][1]] * LANES + lane]++;
+            }
+
+            lanes.rooms[lane] -= total_selected_nodes - 1;
+            if (total_selected_nodes - 1 > total_slots)
+                total_slots = total_selected_nodes - 1;
+        }
+
+        // Relabel every lane's merged rooms in one sweep over the grid
+        if (total_slots > 0)
+        {
+            lanes_t from[8];
+            for (int slot = 0; slot < total_slots; slot++)
+                from[slot] = lanes_load(sources[slot]);
+            lanes_t to = lanes_load(targets);
+
+            for (int c = padded; c < lanes.total_padded - padded; c++)
+            {
+                lanes_t labels = lanes_load(&lanes.labels[c * LANES]);
+                lanes_t merged = lanes_eq(labels, from[0]);
+                for (int slot = 1; slot < total_slots; slot++)
+                    merged = lanes_or(merged, lanes_eq(labels, from[slot]));
+
+                if (lanes_any(merged))
+                    lanes_store(&lanes.labels[c * LANES], lanes_blend(labels, to, merged));
+            }
+        }
+
+        for (int lane = 0; lane < LANES; lane++)
+        {
+            if (!lanes.active[lane] || lanes.rooms[lane] > 1)
+                continue;
+
+            finish_lane(&lanes, lane, totals);
+
+            if (started < total_mazes)
+            {
+                reset_lane(&lanes, lane);
+                started++;
+            }
+            else
+            {
+                lanes.active[lane] = false;
+                total_active--;
+            }
+        }
+    }
+
+    free(lanes.labels);
+    free(lanes.degrees);
+}
@@ -0,0 +1,39 @@
+//
+//  batch_kruskal.h
+//  kruskal-maze-generation-c
+//
+//  Created by Ezzat Chamudi on 10/19/26.
+//  Copyright © 2026 Ezzat Chamudi. All rights reserved.
+//  License: Apache-2.0
+//
+
+#ifndef batch_kruskal_h
+#define batch_kruskal_h
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "definitions.h"
+
+// Largest maze the lockstep kernel takes; every lane keeps its whole grid
+// (plus a one-cell border) next to the others.
+#define BATCH_MAX_SIZE 32
+
+// Totals over every maze of a batch run, in the units of struct maze
+struct batch_totals {
+    long long total_mazes;
+    long long total_passes;
+    long long total_failed_passes;
+    long long total_deg1_nodes;
+    long long total_deg2_nodes;
+    long long total_deg3_nodes;
+    long long total_deg4_nodes;
+};
+
+extern const char *batch_kruskal_backend(void);
+extern int batch_kruskal_lanes(void);
+extern void batch_kruskal(int size, unsigned int direction_options, long long total_mazes, unsigned long long seed, struct batch_totals *totals);
+
+#endif /* batch_kruskal_h */
@@ -0,0 +1,337 @@
+//
+//  bitboard_kruskal.c
+//  kruskal-maze-generation-c
+//
+//  Created by Ezzat Chamudi on 10/19/26.
+//  Copyright © 2026 Ezzat Chamudi. All rights reserved.
+//  License: Apache-2.0
+//
+
+#include "bitboard_kruskal.h"
+
+#include "print_maze.h"
+#include "randomized_kruskal.h"
+
+// randomized_kruskal_walls() for mazes up to 16 x 16. Each room is a bitboard
+// of its cells, so "is this cell in that room" is one bit test, the letter-S
+// check is nine AND + popcounts against the 3x3 window, and a merge ORs the
+// boards together. Passages are two boards (right and bottom) copied into
+// the maze at the end. The RNG is drawn exactly as in the general engine, so
+// every seed gives the same maze.
+
+#define BOARD_SIDE 16
+
+struct bitboard_state {
+    struct bitboard rooms[BOARD_SIDE * BOARD_SIDE];
+    unsigned char room_of[BOARD_SIDE * BOARD_SIDE];
+    struct bitboard right;
+    struct bitboard bottom;
+};
+
+static inline bool bitboard_test(const struct bitboard *board, int bit)
+{
+    return (board->words[bit >> 6] >> (bit & 63)) & 1;
+}
+
+static inline void bitboard_set(struct bitboard *board, int bit)
+{
+    board->words[bit >> 6] |= 1ULL << (bit & 63);
+}
+
+static inline int bitboard_count_and(const struct bitboard *a, const struct bitboard *b)
+{
+    return __builtin_popcountll(a->words[0] & b->words[0])
+        + __builtin_popcountll(a->words[1] & b->words[1])
+        + __builtin_popcountll(a->words[2] & b->words[2])
+        + __builtin_popcountll(a->words[3] & b->words[3]);
+}
+
+static inline int bitboard_count(const struct bitboard *board)
+{
+    return __builtin_popcountll(board->words[0]) + __builtin_popcountll(board->words[1])
+        + __builtin_popcountll(board->words[2]) + __builtin_popcountll(board->words[3]);
+}
+
+// Whether cell is in the room of member
+static inline bool same_room(const struct bitboard_state *state, int member, int cell)
+{
+    return bitboard_test(&state->rooms[state->room_of[member]], cell);
+}
+
+static inline bool unique_3(const struct bitboard_state *state, int a, int b, int c)
+{
+    return !same_room(state, a, b) && !same_room(state, a, c) && !same_room(state, b, c);
+}
+
+static int board_directions(unsigned char *directions, const struct bitboard_state *state, int x, int y, int size, unsigned int options)
+{
+    const bool standard = options & ENABLE_STANDARD;
+    const bool diagonal = options & ENABLE_DIAGONAL;
+    const bool letters = options & ENABLE_LETTERS;
+
+    const bool near_top = y == 0;
+    const bool near_right = x == size - 1;
+    const bool near_bottom = y == size - 1;
+    const bool near_left = x == 0;
+
+    const int mid = x * BOARD_SIDE + y;
+    const int top = mid - 1;
+    const int bottom = mid + 1;
+    const int left = mid - BOARD_SIDE;
+    const int right = mid + BOARD_SIDE;
+
+    int total = 0;
+
+    // Same order as legal_directions()
+    if (diagonal && !near_top && !near_left && unique_3(state, mid, top, left - 1))
+        directions[++total] = TOP_LEFT;
+    if (standard && !near_top && !same_room(state, mid, top))
+        directions[++total] = TOP;
+    if (diagonal && !near_top && !near_right && unique_3(state, mid, top, right - 1))
+        directions[++total] = TOP_RIGHT;
+    if (diagonal && !near_right && !near_top && unique_3(state, mid, right, right - 1))
+        directions[++total] = RIGHT_TOP;
+    if (standard && !near_right && !same_room(state, mid, right))
+        directions[++total] = RIGHT;
+    if (diagonal && !near_right && !near_bottom && unique_3(state, mid, right, right + 1))
+        directions[++total] = RIGHT_BOTTOM;
+    if (diagonal && !near_bottom && !near_right && unique_3(state, mid, bottom, right + 1))
+        directions[++total] = BOTTOM_RIGHT;
+    if (standard && !near_bottom && !same_room(state, mid, bottom))
+        directions[++total] = BOTTOM;
+    if (diagonal && !near_bottom && !near_left && unique_3(state, mid, bottom, left + 1))
+        directions[++total] = BOTTOM_LEFT;
+    if (diagonal && !near_left && !near_bottom && unique_3(state, mid, left, left + 1))
+        directions[++total] = LEFT_BOTTOM;
+    if (standard && !near_left && !same_room(state, mid, left))
+        directions[++total] = LEFT;
+    if (diagonal && !near_left && !near_top && unique_3(state, mid, left, left - 1))
+        directions[++total] = LEFT_TOP;
+
+    if (letters && !near_top && !near_right && !near_bottom && !near_left)
+    {
+        // Nine distinct rooms: each cell's room meets the window only at that cell
+        struct bitboard window = {{0, 0, 0, 0}};
+        for (int dx = -1; dx <= 1; dx++)
+        {
+            for (int dy = -1; dy <= 1; dy++)
+                bitboard_set(&window, mid + dx * BOARD_SIDE + dy);
+        }
+
+        bool unique = true;
+        for (int dx = -1; dx <= 1 && unique; dx++)
+        {
+            for (int dy = -1; dy <= 1 && unique; dy++)
+            {
+                int cell = mid + dx * BOARD_SIDE + dy;
+                unique = bitboard_count_and(&state->rooms[state->room_of[cell]], &window) == 1;
+            }
+        }
+
+        if (unique)
+            directions[++total] = LETTER_S;
+    }
+
+    directions[0] = total;
+    return total;
+}
+
+static void link_cells(struct bitboard_state *state, struct coordinate a, struct coordinate b)
+{
+    if (a.x == b.x)
+        bitboard_set(&state->bottom, a.x * BOARD_SIDE + (a.y < b.y ? a.y : b.y));
+    else
+        bitboard_set(&state->right, (a.x < b.x ? a.x : b.x) * BOARD_SIDE + a.y);
+}
+
+// Links the move's passages and ORs the smaller rooms into the largest one
+static void apply_move(struct bitboard_state *state, const struct coordinate *selected_nodes, int total_selected_nodes, int selected_direction)
+{
+    // Same passages as link_direction_nodes()
+    if (selected_direction == LETTER_S)
+    {
+        static const int s_links[8][2] = {{0, 1}, {1, 2}, {3, 4}, {4, 5}, {6, 7}, {7, 8}, {0, 3}, {5, 8}};
+        for (int i = 0; i < 8; i++)
+            link_cells(state, selected_nodes[s_links[i][0]], selected_nodes[s_links[i][1]]);
+    }
+    else
+    {
+        for (int i = 0; i + 1 < total_selected_nodes; i++)
+            link_cells(state, selected_nodes[i], selected_nodes[i + 1]);
+    }
+
+    int cells[9];
+    int target_room = -1;
+    for (int i = 0; i < total_selected_nodes; i++)
+    {
+        cells[i] = selected_nodes[i].x * BOARD_SIDE + selected_nodes[i].y;
+        int room = state->room_of[cells[i]];
+        if (target_room < 0 || bitboard_count(&state->rooms[room]) > bitboard_count(&state->rooms[target_room]))
+            target_room = room;
+    }
+
+    for (int i = 0; i < total_selected_nodes; i++)
+    {
+        int room = state->room_of[cells[i]];
+        if (room == target_room)
+            continue;
+
+        struct bitboard *merged = &state->rooms[room];
+        for (int w = 0; w < 4; w++)
+        {
+            state->rooms[target_room].words[w] |= merged->words[w];
+
+            for (unsigned long long bits = merged->words[w]; bits; bits &= bits - 1)
+                state->room_of[w * 64 + __builtin_ctzll(bits)] = target_room;
+        }
+    }
+}
+
+static void write_passages(const struct bitboard_state *state, struct maze_walls *walls)
+{
+    int size = walls->size;
+
+    for (int x = 0; x < size; x++)
+    {
+        for (int y = 0; y < size; y++)
+        {
+            int cell = x * BOARD_SIDE + y;
+            unsigned char passages = 0;
+
+            if (bitboard_test(&state->right, cell))
+                passages |= PASSAGE_RIGHT;
+            if (x > 0 && bitboard_test(&state->right, cell - BOARD_SIDE))
+                passages |= PASSAGE_LEFT;
+            if (bitboard_test(&state->bottom, cell))
+                passages |= PASSAGE_BOTTOM;
+            if (y > 0 && bitboard_test(&state->bottom, cell - 1))
+                passages |= PASSAGE_TOP;
+
+            walls->cells[maze_cell_index(walls, x, y)] |= passages;
+        }
+    }
+}
+
+struct maze bitboard_kruskal_walls(struct maze_walls *walls, unsigned int direction_options, struct rng *rng,
+                                  struct event_log *log, struct generation_watch *watch)
+{
+    struct maze result;
+
+    const int size = walls->size;
+    const int total_nodes = size * size;
+
+    struct bitboard_state state;
+    memset(&state.right, 0, sizeof(state.right));
+    memset(&state.bottom, 0, sizeof(state.bottom));
+
+    for (int x = 0; x < size; x++)
+    {
+        for (int y = 0; y < size; y++)
+        {
+            int cell = x * BOARD_SIDE + y;
+            memset(&state.rooms[cell], 0, sizeof(struct bitboard));
+            bitboard_set(&state.rooms[cell], cell);
+            state.room_of[cell] = cell;
+        }
+    }
+
+    int pass_number = 0;
+    int failed_pass_number = 0;
+    int rooms_counter = total_nodes;
+    int fail_streak = 0;
+    const long long max_fail_streak = (long long)size * size * 10;
+    bool stopped = false;
+
+    if ((direction_options & LETTER_PREPASS) && (direction_options & ENABLE_LETTERS))
+    {
+        int total_centers;
+        struct coordinate *centers = letter_prepass(size, rng, &total_centers);
+
+        for (int i = 0; i < total_centers; i++)
+        {
+            pass_number++;
+
+            struct coordinate selected_nodes[9];
+            direction_nodes(selected_nodes, centers[i], LETTER_S);
+            apply_move(&state, selected_nodes, 9, LETTER_S);
+
+            if (log)
+                event_log_append(log, centers[i].x * size + centers[i].y, pass_number, LETTER_S);
+            rooms_counter -= 8;
+
+            if (watch && !watch->merged(watch->context, centers[i].x * size + centers[i].y, pass_number, LETTER_S))
+            {
+                stopped = true;
+                break;
+            }
+        }
+
+        free(centers);
+    }
+
+    while (rooms_counter > 1 && !stopped)
+    {
+        pass_number++;
+
+        struct coordinate node_mid;
+        node_mid.x = rng_range(rng, size);
+        node_mid.y = rng_range(rng, size);
+
+        unsigned char directions[TOTAL_DIRECTIONS + 1];
+        int total_available_directions = board_directions(directions, &state, node_mid.x, node_mid.y, size, direction_options);
+
+        if (total_available_directions == 0)
+        {
+            failed_pass_number++;
+            fail_streak++;
+
+            if (fail_streak > max_fail_streak) {
+                printf("ERROR: Too much fail streak. Can't combine all rooms using legal directions.\n");
+                write_passages(&state, walls);
+                fprint_maze_walls(stdout, walls);
+                exit(1);
+            }
+
+            continue;
+        }
+        fail_streak = 0;
+
+        int selected_direction;
+        if (directions[total_available_directions] == LETTER_S)
+            selected_direction = LETTER_S;
+        else
+            selected_direction = directions[rng_range(rng, total_available_directions) + 1];
+
+        struct coordinate selected_nodes[9];
+        int total_selected_nodes = direction_nodes(selected_nodes, node_mid, selected_direction);
+
+        apply_move(&state, selected_nodes, total_selected_nodes, selected_direction);
+
+        if (log)
+            event_log_append(log, node_mid.x * size + node_mid.y, pass_number, selected_direction);
+
+        rooms_counter -= total_selected_nodes - 1;
+
+        if (watch && !watch->merged(watch->context, node_mid.x * size + node_mid.y, pass_number, selected_direction))
+        {
+            stopped = true;
+            break;
+        }
+    }
+
+    write_passages(&state, walls);
+
+    // An unfinished maze has cells without passages
+    if (stopped)
+        result.total_deg1_nodes = result.total_deg2_nodes = result.total_deg3_nodes = result.total_deg4_nodes = 0;
+    else
+        count_degrees(&result, walls);
+
+    result.total_passes = pass_number;
+    result.total_failed_passes = failed_pass_number;
+    result.size = size;
+    result.graph = NULL;
+    result.total_nodes = total_nodes;
+
+    return result;
+}
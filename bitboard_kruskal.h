@@ -0,0 +1,34 @@
+//
+//  bitboard_kruskal.h
+//  kruskal-maze-generation-c
+//
+//  Created by Ezzat Chamudi on 10/19/26.
+//  Copyright © 2026 Ezzat Chamudi. All rights reserved.
+//  License: Apache-2.0
+//
+
+#ifndef bitboard_kruskal_h
+#define bitboard_kruskal_h
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include "definitions.h"
+#include "event_log.h"
+#include "generation_watch.h"
+#include "maze_walls.h"
+#include "rng.h"
+
+// Largest maze whose cells fit a 256-bit board (16 x 16)
+#define BITBOARD_MAX_SIZE 16
+
+// 256 cells, bit x * 16 + y
+struct bitboard {
+    unsigned long long words[4];
+};
+
+extern struct maze bitboard_kruskal_walls(struct maze_walls *walls, unsigned int direction_options, struct rng *rng,
+                                         struct event_log *log, struct generation_watch *watch);
+
+#endif /* bitboard_kruskal_h */
@@ -0,0 +1,191 @@
+//
+//  chunked_maze.c
+//  kruskal-maze-generation-c
+//
+//  Created by Ezzat Chamudi on 10/19/26.
+//  Copyright © 2026 Ezzat Chamudi. All rights reserved.
+//  License: Apache-2.0
+//
+
+#include "chunked_maze.h"
+
+#include "randomized_kruskal.h"
+#include "rng.h"
+
+static unsigned long long chunk_hash(unsigned long long world_seed, long long chunk_x, long long chunk_y)
+{
+    return rng_derive(rng_derive(world_seed, (unsigned long long)chunk_x), (unsigned long long)chunk_y);
+}
+
+// Side (as a passage flag) towards the parent chunk, 0 for the origin
+static unsigned char chunk_parent(unsigned long long world_seed, long long chunk_x, long long chunk_y)
+{
+    if (chunk_x == 0 && chunk_y == 0)
+        return 0;
+
+    bool horizontal = chunk_x != 0 && (chunk_y == 0 || (rng_derive(chunk_hash(world_seed, chunk_x, chunk_y), 1) & 1));
+
+    if (horizontal)
+        return chunk_x > 0 ? PASSAGE_LEFT : PASSAGE_RIGHT;
+    else
+        return chunk_y > 0 ? PASSAGE_TOP : PASSAGE_BOTTOM;
+}
+
+static unsigned char opposite_side(unsigned char side)
+{
+    switch (side)
+    {
+    case PASSAGE_TOP:
+        return PASSAGE_BOTTOM;
+    case PASSAGE_RIGHT:
+        return PASSAGE_LEFT;
+    case PASSAGE_BOTTOM:
+        return PASSAGE_TOP;
+    default:
+        return PASSAGE_RIGHT;
+    }
+}
+
+static void side_neighbour(long long chunk_x, long long chunk_y, unsigned char side, long long *neighbour_x, long long *neighbour_y)
+{
+    *neighbour_x = chunk_x + (side == PASSAGE_RIGHT) - (side == PASSAGE_LEFT);
+    *neighbour_y = chunk_y + (side == PASSAGE_BOTTOM) - (side == PASSAGE_TOP);
+}
+
+// Where along the border the opening is. Both chunks sharing the border
+// derive it from the same (top or left) chunk.
+static int opening_position(unsigned long long world_seed, int chunk_size, long long chunk_x, long long chunk_y, unsigned char side)
+{
+    long long owner_x = chunk_x - (side == PASSAGE_LEFT);
+    long long owner_y = chunk_y - (side == PASSAGE_TOP);
+    bool vertical = side == PASSAGE_TOP || side == PASSAGE_BOTTOM;
+
+    return (int)(rng_derive(chunk_hash(world_seed, owner_x, owner_y), 2 + vertical) % chunk_size);
+}
+
+struct maze_walls *generate_chunk(unsigned long long world_seed, int chunk_size, unsigned int direction_options, long long chunk_x, long long chunk_y)
+{
+    struct rng rng;
+    rng_seed(&rng, chunk_hash(world_seed, chunk_x, chunk_y));
+
+    struct maze_walls *walls = maze_walls_create(chunk_size);
+    randomized_kruskal_walls(false, walls, direction_options, &rng, NULL);
+
+    const unsigned char sides[4] = {PASSAGE_TOP, PASSAGE_RIGHT, PASSAGE_BOTTOM, PASSAGE_LEFT};
+    unsigned char parent = chunk_parent(world_seed, chunk_x, chunk_y);
+
+    for (int i = 0; i < 4; i++)
+    {
+        long long neighbour_x, neighbour_y;
+        side_neighbour(chunk_x, chunk_y, sides[i], &neighbour_x, &neighbour_y);
+
+        bool open = parent == sides[i] || chunk_parent(world_seed, neighbour_x, neighbour_y) == opposite_side(sides[i]);
+        if (!open)
+            continue;
+
+        // Passages on the chunk border point into the neighbour chunk
+        int position = opening_position(world_seed, chunk_size, chunk_x, chunk_y, sides[i]);
+        int x = sides[i] == PASSAGE_LEFT ? 0 : sides[i] == PASSAGE_RIGHT ? chunk_size - 1 : position;
+        int y = sides[i] == PASSAGE_TOP ? 0 : sides[i] == PASSAGE_BOTTOM ? chunk_size - 1 : position;
+
+        walls->cells[maze_cell_index(walls, x, y)] |= sides[i];
+    }
+
+    return walls;
+}
+
+struct chunk_world *chunk_world_create(unsigned long long world_seed, int chunk_size, unsigned int direction_options, size_t max_bytes)
+{
+    struct chunk_world *world = (struct chunk_world *)calloc(1, sizeof(struct chunk_world));
+    world->world_seed = world_seed;
+    world->chunk_size = chunk_size;
+    world->direction_options = direction_options;
+    world->cache = lru_cache_create(max_bytes);
+    return world;
+}
+
+void chunk_world_free(struct chunk_world *world)
+{
+    lru_cache_free(world->cache);
+    free(world);
+}
+
+const struct maze_walls *chunk_world_chunk(struct chunk_world *world, long long chunk_x, long long chunk_y)
+{
+    // Valid until the next lookup, which may evict it
+    struct cache_key key = {chunk_x, chunk_y, 0};
+    struct maze_walls *walls = lru_cache_get(world->cache, key);
+
+    if (walls == NULL)
+    {
+        walls = generate_chunk(world->world_seed, world->chunk_size, world->direction_options, chunk_x, chunk_y);
+        lru_cache_put(world->cache, key, walls);
+        world->total_generated++;
+    }
+
+    return walls;
+}
+
+static long long floor_div(long long a, long long b)
+{
+    return a / b - ((a % b != 0) && ((a < 0) != (b < 0)));
+}
+
+unsigned char chunk_world_cell(struct chunk_world *world, long long x, long long y)
+{
+    long long chunk_x = floor_div(x, world->chunk_size);
+    long long chunk_y = floor_div(y, world->chunk_size);
+    const struct maze_walls *walls = chunk_world_chunk(world, chunk_x, chunk_y);
+
+    int local_x = (int)(x - chunk_x * world->chunk_size);
+    int local_y = (int)(y - chunk_y * world->chunk_size);
+
+    return walls->cells[maze_cell_index(walls, local_x, local_y)];
+}
+
+void fprint_chunk_world(FILE *stream, struct chunk_world *world, long long x0, long long y0, int width, int height)
+{
+    // Same layout as fprint_maze_walls; openings on the window border show
+    // passages leading out of the window.
+    for (long long y = y0; y < y0 + height; y++)
+    {
+        for (long long x = x0; x < x0 + width; x++)
+        {
+            if (chunk_world_cell(world, x, y) & PASSAGE_TOP) {
+                fprintf(stream, "██  ");
+            } else {
+                fprintf(stream, "████");
+            }
+        }
+
+        // Right most border
+        fprintf(stream, "██\n");
+
+        for (long long x = x0; x < x0 + width; x++)
+        {
+            if (chunk_world_cell(world, x, y) & PASSAGE_LEFT) {
+                fprintf(stream, "    ");
+            } else {
+                fprintf(stream, "██  ");
+            }
+        }
+
+        // Right most border
+        if (chunk_world_cell(world, x0 + width - 1, y) & PASSAGE_RIGHT) {
+            fprintf(stream, "  \n");
+        } else {
+            fprintf(stream, "██\n");
+        }
+    }
+
+    // Bottom border
+    for (long long x = x0; x < x0 + width; x++)
+    {
+        if (chunk_world_cell(world, x, y0 + height - 1) & PASSAGE_BOTTOM) {
+            fprintf(stream, "██  ");
+        } else {
+            fprintf(stream, "████");
+        }
+    }
+    fprintf(stream, "██\n");
+}
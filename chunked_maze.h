@@ -0,0 +1,45 @@
+//
+//  chunked_maze.h
+//  kruskal-maze-generation-c
+//
+//  Created by Ezzat Chamudi on 10/19/26.
+//  Copyright © 2026 Ezzat Chamudi. All rights reserved.
+//  License: Apache-2.0
+//
+
+#ifndef chunked_maze_h
+#define chunked_maze_h
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "definitions.h"
+#include "lru_cache.h"
+#include "maze_walls.h"
+
+// Unbounded maze made of chunk_size x chunk_size Kruskal mazes. Each chunk
+// only depends on (world_seed, chunk_x, chunk_y).
+//
+// Chunks are stitched by a tree over the chunk grid: every chunk except
+// (0, 0) opens exactly one border towards its parent, a neighbour one step
+// closer to the origin (horizontal or vertical, picked by hash when both
+// work). Any chunk knows its own parent and which neighbours pick it, so its
+// openings are known without generating anything else, and the world stays a
+// perfect maze.
+struct chunk_world {
+    unsigned long long world_seed;
+    int chunk_size;
+    unsigned int direction_options;
+    struct lru_cache *cache;
+    long total_generated;
+};
+
+extern struct maze_walls *generate_chunk(unsigned long long world_seed, int chunk_size, unsigned int direction_options, long long chunk_x, long long chunk_y);
+
+extern struct chunk_world *chunk_world_create(unsigned long long world_seed, int chunk_size, unsigned int direction_options, size_t max_bytes);
+extern void chunk_world_free(struct chunk_world *world);
+extern const struct maze_walls *chunk_world_chunk(struct chunk_world *world, long long chunk_x, long long chunk_y);
+extern unsigned char chunk_world_cell(struct chunk_world *world, long long x, long long y);
+extern void fprint_chunk_world(FILE *stream, struct chunk_world *world, long long x0, long long y0, int width, int height);
+
+#endif /* chunked_maze_h */
@@ -48,4 +48,16 @@ struct coordinate {
 
 #define LETTER_S 12
 
+#define ENABLE_STANDARD 0b00000001
+#define ENABLE_DIAGONAL 0b00000010
+#define ENABLE_LETTERS  0b00000100
+
+// Draw uniformly over legal (cell, direction) pairs instead of the original
+// cell-then-direction selection
+#define UNIFORM_SAMPLING 0b00001000
+
+// With ENABLE_LETTERS, place a random maximal set of non-overlapping
+// letter-S shapes in bulk before the random passes (see letter_prepass.h)
+#define LETTER_PREPASS 0b00010000
+
 #endif /* definitions_h */
@@ -0,0 +1,129 @@
+//
+//  eller.c
+//  kruskal-maze-generation-c
+//
+//  Created by Ezzat Chamudi on 10/19/26.
+//  Copyright © 2026 Ezzat Chamudi. All rights reserved.
+//  License: Apache-2.0
+//
+
+#include "eller.h"
+
+#include "randomized_kruskal.h"
+
+// Eller's algorithm: build the maze one row (fixed y) at a time, keeping only
+// the current row's sets. Neighbouring cells of different sets are joined at
+// random. Each set then sends at least one passage down to the next row. The
+// last row joins everything that is still apart.
+//
+// Cost: O(n α(size)). Memory is O(size), a few ints per column, whatever the
+// maze height, so rows could be streamed out as they are finished. Standard
+// directions only.
+
+void eller_walls(struct maze_walls *walls, struct rng *rng)
+{
+    const int size = walls->size;
+
+    // A row holds at most size sets, so 2 * size ids cover the carried-over
+    // sets plus fresh ones for the next row
+    const int total_ids = 2 * size;
+
+    int *row = (int *)malloc((size_t)size * sizeof(int));
+    int *sets = (int *)malloc((size_t)total_ids * sizeof(int));
+    int *members = (int *)malloc((size_t)total_ids * sizeof(int));
+    int *chosen = (int *)malloc((size_t)total_ids * sizeof(int));
+    bool *down = (bool *)malloc((size_t)size * sizeof(bool));
+    bool *has_down = (bool *)malloc((size_t)total_ids * sizeof(bool));
+    bool *used = (bool *)malloc((size_t)total_ids * sizeof(bool));
+
+    for (int x = 0; x < size; x++)
+        row[x] = x;
+
+    for (int y = 0; y < size; y++)
+    {
+        bool last_row = y == size - 1;
+
+        for (int id = 0; id < total_ids; id++)
+            sets[id] = id;
+
+        // Join neighbours in the row
+        for (int x = 0; x + 1 < size; x++)
+        {
+            int a = find_room(sets, row[x]);
+            int b = find_room(sets, row[x + 1]);
+            if (a == b || (!last_row && rng_range(rng, 2) == 0))
+                continue;
+
+            sets[b] = a;
+
+            struct coordinate left = {x, y};
+            struct coordinate right = {x + 1, y};
+            maze_walls_link(walls, left, right);
+        }
+
+        if (last_row)
+            break;
+
+        // Each set goes down at least once: random cells, plus one member
+        // picked by reservoir sampling for sets that drew none
+        for (int id = 0; id < total_ids; id++)
+        {
+            members[id] = 0;
+            has_down[id] = false;
+            used[id] = false;
+        }
+
+        for (int x = 0; x < size; x++)
+        {
+            row[x] = find_room(sets, row[x]);
+            int set = row[x];
+
+            members[set]++;
+            if (rng_range(rng, members[set]) == 0)
+                chosen[set] = x;
+
+            down[x] = rng_range(rng, 2) == 0;
+            if (down[x])
+                has_down[set] = true;
+        }
+
+        for (int x = 0; x < size; x++)
+        {
+            if (!has_down[row[x]] && chosen[row[x]] == x)
+                down[x] = true;
+        }
+
+        // Carry sets down; cells left behind get fresh ids
+        for (int x = 0; x < size; x++)
+        {
+            if (!down[x])
+                continue;
+
+            used[row[x]] = true;
+
+            struct coordinate above = {x, y};
+            struct coordinate below = {x, y + 1};
+            maze_walls_link(walls, above, below);
+        }
+
+        int fresh = 0;
+        for (int x = 0; x < size; x++)
+        {
+            if (down[x])
+                continue;
+
+            while (used[fresh])
+                fresh++;
+            used[fresh] = true;
+            row[x] = fresh;
+        }
+    }
+
+    free(row);
+    free(sets);
+    free(members);
+    free(chosen);
+    free(down);
+    free(has_down);
+    free(used);
+}
@@ -0,0 +1,22 @@
+//
+//  eller.h
+//  kruskal-maze-generation-c
+//
+//  Created by Ezzat Chamudi on 10/19/26.
+//  Copyright © 2026 Ezzat Chamudi. All rights reserved.
+//  License: Apache-2.0
+//
+
+#ifndef eller_h
+#define eller_h
+
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include "definitions.h"
+#include "maze_walls.h"
+#include "rng.h"
+
+extern void eller_walls(struct maze_walls *walls, struct rng *rng);
+
+#endif /* eller_h */
@@ -1,16 +1,32 @@
 emcc \
     web.c \
+    batch_kruskal.c \
+    bitboard_kruskal.c \
     definitions.c \
+    event_log.c \
+    fenwick.c \
+    letter_prepass.c \
     print_maze_draft.c \
+    maze_allocator.c \
+    maze_tiles.c \
+    maze_walls.c \
     print_maze.c \
     randomized_kruskal.c \
+    rng.c \
     stats.c \
+    uniform_kruskal.c \
     util.c \
     \
     -o ./dist/script.js \
     \
     -s EXPORTED_FUNCTIONS='[
-        "_web_randomized_kruskal"
+        "_web_randomized_kruskal",
+        "_web_generate_log",
+        "_web_log_events",
+        "_web_replay_cells",
+        "_web_replay_seek",
+        "_web_viewer_generate",
+        "_web_viewer_tile"
     ]' \
     \
     -s EXTRA_EXPORTED_RUNTIME_METHODS='[
@@ -0,0 +1,222 @@
+//
+//  event_log.c
+//  kruskal-maze-generation-c
+//
+//  Created by Ezzat Chamudi on 10/19/26.
+//  Copyright © 2026 Ezzat Chamudi. All rights reserved.
+//  License: Apache-2.0
+//
+
+#include "event_log.h"
+
+#include <string.h>
+
+#include "randomized_kruskal.h"
+
+struct event_log *event_log_create(int size, unsigned int direction_options)
+{
+    struct event_log *log = (struct event_log *)calloc(1, sizeof(struct event_log));
+    log->size = size;
+    log->direction_options = direction_options;
+    return log;
+}
+
+void event_log_free(struct event_log *log)
+{
+    if (log == NULL)
+        return;
+    free(log->events);
+    free(log);
+}
+
+void event_log_append(struct event_log *log, unsigned int cell, unsigned int pass, unsigned char direction)
+{
+    if (log->total_events == log->capacity)
+    {
+        log->capacity = log->capacity ? log->capacity * 2 : 1024;
+        log->events = (struct generation_event *)realloc(log->events, log->capacity * sizeof(struct generation_event));
+    }
+
+    struct generation_event *event = &log->events[log->total_events++];
+    event->cell = cell;
+    event->pass = pass;
+    event->direction = direction;
+}
+
+int event_log_position_at_pass(const struct event_log *log, unsigned int pass)
+{
+    // Number of events that happened up to and including the pass
+    int low = 0;
+    int high = log->total_events;
+
+    while (low < high)
+    {
+        int middle = low + (high - low) / 2;
+        if (log->events[middle].pass <= pass)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+
+    return low;
+}
+
+static void put_u32(unsigned char *bytes, unsigned int value)
+{
+    bytes[0] = value & 0xFF;
+    bytes[1] = (value >> 8) & 0xFF;
+    bytes[2] = (value >> 16) & 0xFF;
+    bytes[3] = (value >> 24) & 0xFF;
+}
+
+static unsigned int get_u32(const unsigned char *bytes)
+{
+    return bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | ((unsigned int)bytes[3] << 24);
+}
+
+// Little-endian: magic, version, size, options, total events, then 9 bytes
+// per event (cell, pass, direction).
+bool event_log_write(const struct event_log *log, FILE *stream)
+{
+    unsigned char header[20];
+    memcpy(header, EVENT_LOG_MAGIC, 4);
+    put_u32(header + 4, EVENT_LOG_VERSION);
+    put_u32(header + 8, log->size);
+    put_u32(header + 12, log->direction_options);
+    put_u32(header + 16, log->total_events);
+
+    if (fwrite(header, 1, sizeof(header), stream) != sizeof(header))
+        return false;
+
+    for (int i = 0; i < log->total_events; i++)
+    {
+        unsigned char record[9];
+        put_u32(record, log->events[i].cell);
+        put_u32(record + 4, log->events[i].pass);
+        record[8] = log->events[i].direction;
+
+        if (fwrite(record, 1, sizeof(record), stream) != sizeof(record))
+            return false;
+    }
+
+    return true;
+}
+
+// Whether replaying the event only touches cells inside the grid
+static bool event_in_grid(int size, unsigned int cell, unsigned char direction)
+{
+    if (cell >= (unsigned int)size * size || direction > LETTER_S)
+        return false;
+
+    struct coordinate node_mid;
+    node_mid.x = cell / size;
+    node_mid.y = cell % size;
+
+    struct coordinate selected_nodes[9];
+    int total_selected_nodes = direction_nodes(selected_nodes, node_mid, direction);
+
+    // Coordinates are unsigned, so a step past the top or left wraps around
+    for (int i = 0; i < total_selected_nodes; i++)
+    {
+        if (selected_nodes[i].x >= (unsigned int)size || selected_nodes[i].y >= (unsigned int)size)
+            return false;
+    }
+
+    return true;
+}
+
+// NULL on a bad header or any event that doesn't fit the grid
+struct event_log *event_log_read(FILE *stream)
+{
+    unsigned char header[20];
+
+    if (fread(header, 1, sizeof(header), stream) != sizeof(header)
+        || memcmp(header, EVENT_LOG_MAGIC, 4) != 0
+        || get_u32(header + 4) != EVENT_LOG_VERSION)
+        return NULL;
+
+    unsigned int size = get_u32(header + 8);
+    unsigned int total_events = get_u32(header + 16);
+
+    // Every event merges rooms, so there are fewer events than cells
+    if (size < 2 || size > MAZE_MAX_SIZE || total_events >= size * size)
+        return NULL;
+
+    struct event_log *log = event_log_create(size, get_u32(header + 12));
+
+    log->capacity = total_events ? total_events : 1;
+    log->events = (struct generation_event *)calloc(log->capacity, sizeof(struct generation_event));
+
+    if (log->events == NULL)
+    {
+        event_log_free(log);
+        return NULL;
+    }
+
+    for (unsigned int i = 0; i < total_events; i++)
+    {
+        unsigned char record[9];
+        if (fread(record, 1, sizeof(record), stream) != sizeof(record)
+            || !event_in_grid(size, get_u32(record), record[8]))
+        {
+            event_log_free(log);
+            return NULL;
+        }
+        event_log_append(log, get_u32(record), get_u32(record + 4), record[8]);
+    }
+
+    return log;
+}
+
+struct event_replayer *event_replayer_create(const struct event_log *log)
+{
+    struct event_replayer *replayer = (struct event_replayer *)calloc(1, sizeof(struct event_replayer));
+    replayer->log = log;
+    replayer->walls = maze_walls_create(log->size);
+    replayer->position = 0;
+    return replayer;
+}
+
+void event_replayer_free(struct event_replayer *replayer)
+{
+    maze_walls_free(replayer->walls);
+    free(replayer);
+}
+
+static void replay_event(struct event_replayer *replayer, const struct generation_event *event, bool forward)
+{
+    int size = replayer->log->size;
+    struct coordinate node_mid;
+    node_mid.x = event->cell / size;
+    node_mid.y = event->cell % size;
+
+    struct coordinate selected_nodes[9];
+    direction_nodes(selected_nodes, node_mid, event->direction);
+
+    if (forward)
+        link_direction_nodes(replayer->walls, selected_nodes, event->direction);
+    else
+        unlink_direction_nodes(replayer->walls, selected_nodes, event->direction);
+}
+
+void event_replayer_seek(struct event_replayer *replayer, int position)
+{
+    // Every merge joins separate rooms, so its passages were all closed
+    // before it and stepping backwards just closes them again.
+    if (position < 0)
+        position = 0;
+    if (position > replayer->log->total_events)
+        position = replayer->log->total_events;
+
+    while (replayer->position < position)
+    {
+        replay_event(replayer, &replayer->log->events[replayer->position], true);
+        replayer->position++;
+    }
+
+    while (replayer->position > position)
+    {
+        replayer->position--;
+        replay_event(replayer, &replayer->log->events[replayer->position], false);
+    }
+}
@@ -0,0 +1,57 @@
+//
+//  event_log.h
+//  kruskal-maze-generation-c
+//
+//  Created by Ezzat Chamudi on 10/19/26.
+//  Copyright © 2026 Ezzat Chamudi. All rights reserved.
+//  License: Apache-2.0
+//
+
+#ifndef event_log_h
+#define event_log_h
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include "definitions.h"
+#include "maze_walls.h"
+
+#define EVENT_LOG_MAGIC "KMEL"
+#define EVENT_LOG_VERSION 1
+
+// One successful merge: the selected middle node, its direction code and the
+// pass it happened in. Failed passes are not recorded.
+struct generation_event {
+    unsigned int cell;
+    unsigned int pass;
+    unsigned char direction;
+};
+
+struct event_log {
+    int size;
+    unsigned int direction_options;
+    struct generation_event *events;
+    int total_events;
+    int capacity;
+};
+
+// Rebuilds the maze as it was after any number of events
+struct event_replayer {
+    const struct event_log *log;
+    struct maze_walls *walls;
+    int position;
+};
+
+extern struct event_log *event_log_create(int size, unsigned int direction_options);
+extern void event_log_free(struct event_log *log);
+extern void event_log_append(struct event_log *log, unsigned int cell, unsigned int pass, unsigned char direction);
+extern int event_log_position_at_pass(const struct event_log *log, unsigned int pass);
+extern bool event_log_write(const struct event_log *log, FILE *stream);
+extern struct event_log *event_log_read(FILE *stream);
+
+extern struct event_replayer *event_replayer_create(const struct event_log *log);
+extern void event_replayer_free(struct event_replayer *replayer);
+extern void event_replayer_seek(struct event_replayer *replayer, int position);
+
+#endif /* event_log_h */
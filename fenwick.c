@@ -0,0 +1,61 @@
+//
+//  fenwick.c
+//  kruskal-maze-generation-c
+//
+//  Created by Ezzat Chamudi on 10/19/26.
+//  Copyright © 2026 Ezzat Chamudi. All rights reserved.
+//  License: Apache-2.0
+//
+
+#include "fenwick.h"
+
+struct fenwick *fenwick_create(int total)
+{
+    struct fenwick *fenwick = (struct fenwick *)calloc(1, sizeof(struct fenwick));
+    fenwick->total = total;
+    fenwick->tree = (long long *)calloc(total + 1, sizeof(long long));
+
+    fenwick->highest_step = 1;
+    while (fenwick->highest_step * 2 <= total)
+        fenwick->highest_step *= 2;
+
+    return fenwick;
+}
+
+void fenwick_free(struct fenwick *fenwick)
+{
+    free(fenwick->tree);
+    free(fenwick);
+}
+
+void fenwick_add(struct fenwick *fenwick, int index, long long delta)
+{
+    for (int i = index + 1; i <= fenwick->total; i += i & -i)
+        fenwick->tree[i] += delta;
+}
+
+long long fenwick_sum(const struct fenwick *fenwick)
+{
+    long long sum = 0;
+    for (int i = fenwick->total; i > 0; i -= i & -i)
+        sum += fenwick->tree[i];
+    return sum;
+}
+
+int fenwick_find(const struct fenwick *fenwick, long long *target)
+{
+    // Index whose count range covers target (0 <= target < sum); target is
+    // left as the offset inside that index's count.
+    int position = 0;
+
+    for (int step = fenwick->highest_step; step > 0; step /= 2)
+    {
+        if (position + step <= fenwick->total && fenwick->tree[position + step] <= *target)
+        {
+            position += step;
+            *target -= fenwick->tree[position];
+        }
+    }
+
+    return position;
+}
@@ -0,0 +1,29 @@
+//
+//  fenwick.h
+//  kruskal-maze-generation-c
+//
+//  Created by Ezzat Chamudi on 10/19/26.
+//  Copyright © 2026 Ezzat Chamudi. All rights reserved.
+//  License: Apache-2.0
+//
+
+#ifndef fenwick_h
+#define fenwick_h
+
+#include <stdlib.h>
+
+// Fenwick (binary indexed) tree of non-negative counts: point updates,
+// prefix sums and weighted lookups in O(log n).
+struct fenwick {
+    int total;
+    int highest_step;
+    long long *tree;
+};
+
+extern struct fenwick *fenwick_create(int total);
+extern void fenwick_free(struct fenwick *fenwick);
+extern void fenwick_add(struct fenwick *fenwick, int index, long long delta);
+extern long long fenwick_sum(const struct fenwick *fenwick);
+extern int fenwick_find(const struct fenwick *fenwick, long long *target);
+
+#endif /* fenwick_h */
@@ -0,0 +1,23 @@
+//
+//  generation_watch.h
+//  kruskal-maze-generation-c
+//
+//  Created by Ezzat Chamudi on 10/19/26.
+//  Copyright © 2026 Ezzat Chamudi. All rights reserved.
+//  License: Apache-2.0
+//
+
+#ifndef generation_watch_h
+#define generation_watch_h
+
+#include <stdbool.h>
+
+// Called after every successful merge with the selected middle node, its
+// direction code and the pass; returning false stops the generation there,
+// leaving the maze unfinished. Lets a search give up on a candidate early.
+struct generation_watch {
+    bool (*merged)(void *context, unsigned int cell, unsigned int pass, unsigned char direction);
+    void *context;
+};
+
+#endif /* generation_watch_h */
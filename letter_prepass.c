@@ -0,0 +1,198 @@
+//
+//  letter_prepass.c
+//  kruskal-maze-generation-c
+//
+//  Created by Ezzat Chamudi on 10/19/26.
+//  Copyright © 2026 Ezzat Chamudi. All rights reserved.
+//  License: Apache-2.0
+//
+
+#include "letter_prepass.h"
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
+
+struct stripe_job {
+    int width;
+    int height;
+    unsigned char *taken;
+    unsigned long long seed;
+
+    int first_stripe;
+    int total_stripes;
+    int stride;
+
+    // Centers found per stripe
+    struct coordinate **centers;
+    int *total_centers;
+
+    bool threaded;
+};
+
+static bool window_free(const unsigned char *taken, int height, int x, int y)
+{
+    for (int dx = -1; dx <= 1; dx++)
+    {
+        const unsigned char *column = taken + (size_t)(x + dx) * height + y;
+        if (column[-1] | column[0] | column[1])
+            return false;
+    }
+    return true;
+}
+
+static void fill_stripe(struct stripe_job *job, int stripe)
+{
+    const int width = job->width;
+    const int x_begin = stripe * LETTER_PREPASS_STRIPE > 1 ? stripe * LETTER_PREPASS_STRIPE : 1;
+    const int x_end = (stripe + 1) * LETTER_PREPASS_STRIPE < width - 1 ? (stripe + 1) * LETTER_PREPASS_STRIPE : width - 1;
+    const int height = job->height - 2;
+
+    job->centers[stripe] = NULL;
+    job->total_centers[stripe] = 0;
+    if (x_end <= x_begin || height <= 0)
+        return;
+
+    const int total_candidates = (x_end - x_begin) * height;
+    int *order = (int *)malloc(total_candidates * sizeof(int));
+
+    // Windows don't overlap and fit in the stripe plus a border
+    size_t capacity = (size_t)((x_end - x_begin + 2) / 3 + 1) * ((height + 2) / 3 + 1);
+    struct coordinate *centers = (struct coordinate *)malloc(capacity * sizeof(struct coordinate));
+    int total_centers = 0;
+
+    struct rng rng;
+    rng_seed(&rng, rng_derive(job->seed, stripe));
+
+    // Visit the stripe's centers in a random order, keeping every window
+    // that is still free
+    for (int i = 0; i < total_candidates; i++)
+        order[i] = i;
+
+    for (int i = total_candidates - 1; i > 0; i--)
+    {
+        int j = rng_range(&rng, i + 1);
+        int candidate = order[i];
+        order[i] = order[j];
+        order[j] = candidate;
+    }
+
+    for (int i = 0; i < total_candidates; i++)
+    {
+        int x = x_begin + order[i] / height;
+        int y = 1 + order[i] % height;
+
+        if (!window_free(job->taken, job->height, x, y))
+            continue;
+
+        for (int dx = -1; dx <= 1; dx++)
+            memset(job->taken + (size_t)(x + dx) * job->height + y - 1, 1, 3);
+
+        centers[total_centers].x = x;
+        centers[total_centers].y = y;
+        total_centers++;
+    }
+
+    free(order);
+    job->centers[stripe] = centers;
+    job->total_centers[stripe] = total_centers;
+}
+
+static void *stripe_thread(void *argument)
+{
+    struct stripe_job *job = (struct stripe_job *)argument;
+
+    for (int stripe = job->first_stripe; stripe < job->total_stripes; stripe += job->stride)
+        fill_stripe(job, stripe);
+
+    return NULL;
+}
+
+struct coordinate *letter_prepass(int size, struct rng *rng, int *total_centers)
+{
+    return letter_prepass_rect(size, size, rng, total_centers);
+}
+
+struct coordinate *letter_prepass_rect(int width, int height, struct rng *rng, int *total_centers)
+{
+    const int total_stripes = (width + LETTER_PREPASS_STRIPE - 1) / LETTER_PREPASS_STRIPE;
+
+    int total_threads = 1;
+    if ((long long)width * height >= (long long)LETTER_PREPASS_THREADED_SIZE * LETTER_PREPASS_THREADED_SIZE)
+    {
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        total_threads = online > 1 ? (int)online : 1;
+        if (total_threads > (total_stripes + 1) / 2)
+            total_threads = (total_stripes + 1) / 2;
+    }
+
+    unsigned char *taken = (unsigned char *)calloc((size_t)width * height, sizeof(unsigned char));
+    struct coordinate **stripe_centers = (struct coordinate **)calloc(total_stripes, sizeof(struct coordinate *));
+    int *stripe_totals = (int *)calloc(total_stripes, sizeof(int));
+
+    struct stripe_job *jobs = (struct stripe_job *)calloc(total_threads, sizeof(struct stripe_job));
+    pthread_t *threads = (pthread_t *)calloc(total_threads, sizeof(pthread_t));
+    unsigned long long seed = rng_next(rng);
+
+    // Even stripes, then odd ones. Stripes of a phase are a stripe apart,
+    // so their windows never touch the same cell.
+    for (int phase = 0; phase < 2; phase++)
+    {
+        for (int t = 0; t < total_threads; t++)
+        {
+            jobs[t].width = width;
+            jobs[t].height = height;
+            jobs[t].taken = taken;
+            jobs[t].seed = seed;
+            jobs[t].first_stripe = phase + 2 * t;
+            jobs[t].total_stripes = total_stripes;
+            jobs[t].stride = 2 * total_threads;
+            jobs[t].centers = stripe_centers;
+            jobs[t].total_centers = stripe_totals;
+
+            jobs[t].threaded = t > 0 && pthread_create(&threads[t], NULL, stripe_thread, &jobs[t]) == 0;
+        }
+
+        // Stripes whose thread couldn't be started are filled here; every
+        // stripe has its own seed, so the result is the same
+        for (int t = 0; t < total_threads; t++)
+        {
+            if (!jobs[t].threaded)
+                stripe_thread(&jobs[t]);
+        }
+
+        for (int t = 1; t < total_threads; t++)
+        {
+            if (jobs[t].threaded)
+                pthread_join(threads[t], NULL);
+        }
+    }
+
+    // Placement order: even stripes left to right, then odd ones
+    int total = 0;
+    for (int stripe = 0; stripe < total_stripes; stripe++)
+        total += stripe_totals[stripe];
+
+    struct coordinate *centers = (struct coordinate *)malloc((total + 1) * sizeof(struct coordinate));
+    int position = 0;
+    for (int phase = 0; phase < 2; phase++)
+    {
+        for (int stripe = phase; stripe < total_stripes; stripe += 2)
+        {
+            if (stripe_totals[stripe] > 0)
+                memcpy(centers + position, stripe_centers[stripe], stripe_totals[stripe] * sizeof(struct coordinate));
+            position += stripe_totals[stripe];
+            free(stripe_centers[stripe]);
+        }
+    }
+
+    free(taken);
+    free(stripe_centers);
+    free(stripe_totals);
+    free(jobs);
+    free(threads);
+
+    *total_centers = total;
+    return centers;
+}
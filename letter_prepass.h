@@ -0,0 +1,39 @@
+//
+//  letter_prepass.h
+//  kruskal-maze-generation-c
+//
+//  Created by Ezzat Chamudi on 10/19/26.
+//  Copyright © 2026 Ezzat Chamudi. All rights reserved.
+//  License: Apache-2.0
+//
+
+#ifndef letter_prepass_h
+#define letter_prepass_h
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "definitions.h"
+#include "rng.h"
+
+// Columns per stripe. Stripes must be at least 3 wide so that two stripes
+// of the same phase never reach the same cell.
+#define LETTER_PREPASS_STRIPE 64
+
+// Smallest maze worth spreading over threads, by side of a square with as
+// many cells
+#define LETTER_PREPASS_THREADED_SIZE 1024
+
+// Middle nodes of a randomized maximal set of non-overlapping letter-S
+// windows on a fresh size x size grid, in placement order. Every window
+// fully inside the grid either is in the set or overlaps one that is.
+//
+// The grid is cut into column stripes. Even stripes are filled in parallel,
+// then odd ones; each stripe visits its centers in a random order from its
+// own rng, derived from one draw of rng, so the set doesn't depend on the
+// thread count. Returns a malloc'd array.
+extern struct coordinate *letter_prepass(int size, struct rng *rng, int *total_centers);
+// The same on a width x height grid; letter_prepass() is the square case
+extern struct coordinate *letter_prepass_rect(int width, int height, struct rng *rng, int *total_centers);
+
+#endif /* letter_prepass_h */
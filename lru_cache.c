@@ -0,0 +1,134 @@
+//
+//  lru_cache.c
+//  kruskal-maze-generation-c
+//
+//  Created by Ezzat Chamudi on 10/19/26.
+//  Copyright © 2026 Ezzat Chamudi. All rights reserved.
+//  License: Apache-2.0
+//
+
+#include "lru_cache.h"
+
+static unsigned int key_bucket(struct cache_key key)
+{
+    unsigned long long hash = (unsigned long long)key.a * 0x9E3779B97F4A7C15ULL;
+    hash ^= (unsigned long long)key.b * 0xC2B2AE3D27D4EB4FULL;
+    hash ^= (unsigned long long)key.c * 0x165667B19E3779F9ULL;
+    hash ^= hash >> 29;
+    return (unsigned int)(hash % LRU_CACHE_BUCKETS);
+}
+
+static bool key_equal(struct cache_key a, struct cache_key b)
+{
+    return a.a == b.a && a.b == b.b && a.c == b.c;
+}
+
+static void unlink_entry(struct lru_cache *cache, struct lru_entry *entry)
+{
+    if (entry->prev)
+        entry->prev->next = entry->next;
+    else
+        cache->head = entry->next;
+
+    if (entry->next)
+        entry->next->prev = entry->prev;
+    else
+        cache->tail = entry->prev;
+
+    entry->prev = NULL;
+    entry->next = NULL;
+}
+
+static void push_front(struct lru_cache *cache, struct lru_entry *entry)
+{
+    entry->prev = NULL;
+    entry->next = cache->head;
+
+    if (cache->head)
+        cache->head->prev = entry;
+    cache->head = entry;
+
+    if (cache->tail == NULL)
+        cache->tail = entry;
+}
+
+static void remove_entry(struct lru_cache *cache, struct lru_entry *entry)
+{
+    struct lru_entry **link = &cache->buckets[key_bucket(entry->key)];
+    while (*link != entry)
+        link = &(*link)->bucket_next;
+    *link = entry->bucket_next;
+
+    unlink_entry(cache, entry);
+
+    cache->bytes -= entry->bytes;
+    cache->total_entries--;
+
+    maze_walls_free(entry->walls);
+    free(entry);
+}
+
+struct lru_cache *lru_cache_create(size_t max_bytes)
+{
+    struct lru_cache *cache = (struct lru_cache *)calloc(1, sizeof(struct lru_cache));
+    cache->max_bytes = max_bytes;
+    return cache;
+}
+
+void lru_cache_free(struct lru_cache *cache)
+{
+    while (cache->tail)
+        remove_entry(cache, cache->tail);
+    free(cache);
+}
+
+struct maze_walls *lru_cache_get(struct lru_cache *cache, struct cache_key key)
+{
+    struct lru_entry *entry = cache->buckets[key_bucket(key)];
+
+    while (entry && !key_equal(entry->key, key))
+        entry = entry->bucket_next;
+
+    if (entry == NULL)
+    {
+        cache->misses++;
+        return NULL;
+    }
+
+    cache->hits++;
+
+    unlink_entry(cache, entry);
+    push_front(cache, entry);
+
+    return entry->walls;
+}
+
+void lru_cache_put(struct lru_cache *cache, struct cache_key key, struct maze_walls *walls)
+{
+    // The cache owns walls from here on
+    struct lru_entry *entry = cache->buckets[key_bucket(key)];
+
+    while (entry && !key_equal(entry->key, key))
+        entry = entry->bucket_next;
+
+    if (entry)
+        remove_entry(cache, entry);
+
+    entry = (struct lru_entry *)calloc(1, sizeof(struct lru_entry));
+    entry->key = key;
+    entry->walls = walls;
+    entry->bytes = sizeof(struct maze_walls) + (size_t)walls->total_cells;
+
+    unsigned int bucket = key_bucket(key);
+    entry->bucket_next = cache->buckets[bucket];
+    cache->buckets[bucket] = entry;
+
+    push_front(cache, entry);
+
+    cache->bytes += entry->bytes;
+    cache->total_entries++;
+
+    // Keep at least the newest entry even when it alone exceeds the budget
+    while (cache->bytes > cache->max_bytes && cache->tail != entry)
+        remove_entry(cache, cache->tail);
+}
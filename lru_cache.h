@@ -0,0 +1,53 @@
+//
+//  lru_cache.h
+//  kruskal-maze-generation-c
+//
+//  Created by Ezzat Chamudi on 10/19/26.
+//  Copyright © 2026 Ezzat Chamudi. All rights reserved.
+//  License: Apache-2.0
+//
+
+#ifndef lru_cache_h
+#define lru_cache_h
+
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include "maze_walls.h"
+
+#define LRU_CACHE_BUCKETS 4096
+
+struct cache_key {
+    long long a;
+    long long b;
+    long long c;
+};
+
+struct lru_entry {
+    struct cache_key key;
+    struct maze_walls *walls;
+    size_t bytes;
+    struct lru_entry *prev;
+    struct lru_entry *next;
+    struct lru_entry *bucket_next;
+};
+
+// Least recently used mazes are evicted once the cached cells exceed
+// max_bytes. Not thread safe, callers hold their own lock.
+struct lru_cache {
+    struct lru_entry *buckets[LRU_CACHE_BUCKETS];
+    struct lru_entry *head;
+    struct lru_entry *tail;
+    size_t bytes;
+    size_t max_bytes;
+    int total_entries;
+    long hits;
+    long misses;
+};
+
+extern struct lru_cache *lru_cache_create(size_t max_bytes);
+extern void lru_cache_free(struct lru_cache *cache);
+extern struct maze_walls *lru_cache_get(struct lru_cache *cache, struct cache_key key);
+extern void lru_cache_put(struct lru_cache *cache, struct cache_key key, struct maze_walls *walls);
+
+#endif /* lru_cache_h */
@@ -13,15 +13,988 @@
 #include <limits.h>
 #include <stdbool.h>
 #include <time.h>
+#include <string.h>
+#include <unistd.h>
 
+#include "chunked_maze.h"
 #include "definitions.h"
+#include "event_log.h"
+#include "masked_kruskal.h"
+#include "maze_archive.h"
+#include "maze_engine.h"
+#include "maze_mask.h"
 #include "print_maze.h"
 #include "randomized_kruskal.h"
+#include "regenerate_region.h"
+#include "seed_search.h"
+#include "server.h"
 #include "stats.h"
+#include "stats_shard.h"
+#include "sweep.h"
 #include "util.h"
+#include "validate_maze.h"
+
+static int serve(int argc, const char *argv[])
+{
+    // serve [socket_path] [--workers N] [--cache-mb M] [--max-size S] [--pool size:options[:capacity]]...
+    struct server_config config;
+    config.socket_path = "/tmp/kruskal-maze.sock";
+    config.pools = (struct maze_pool_config *)calloc(argc, sizeof(struct maze_pool_config));
+    config.total_pools = 0;
+    config.total_workers = 2;
+    config.cache_bytes = 64 * 1024 * 1024;
+    config.max_size = 4096;
+
+    for (int i = 2; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--workers") == 0 && i + 1 < argc) {
+            config.total_workers = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--cache-mb") == 0 && i + 1 < argc) {
+            config.cache_bytes = (size_t)atol(argv[++i]) * 1024 * 1024;
+        } else if (strcmp(argv[i], "--max-size") == 0 && i + 1 < argc) {
+            config.max_size = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--pool") == 0 && i + 1 < argc) {
+            char options_text[32] = "";
+            struct maze_pool_config *pool = &config.pools[config.total_pools];
+            pool->capacity = 16;
+
+            if (sscanf(argv[++i], "%d:%31[^:]:%d", &pool->size, options_text, &pool->capacity) < 2) {
+                printf("ERROR: Bad pool %s, expected size:options[:capacity].\n", argv[i]);
+                return 1;
+            }
+            pool->direction_options = parse_direction_options(options_text);
+            config.total_pools++;
+        } else {
+            config.socket_path = argv[i];
+        }
+    }
+
+    int status = run_server(&config);
+    free(config.pools);
+    return status;
+}
+
+static double seconds_since(struct timeval start)
+{
+    struct timeval now;
+    gettimeofday(&now, NULL);
+    return (now.tv_sec - start.tv_sec) + (now.tv_usec - start.tv_usec) / 1e6;
+}
+
+// Options without standard links can fail to join all rooms
+static bool check_direction_options(unsigned int direction_options)
+{
+    if (!(direction_options & ENABLE_STANDARD)
+        || (direction_options & ~(unsigned int)(ENABLE_STANDARD | ENABLE_DIAGONAL | ENABLE_LETTERS | UNIFORM_SAMPLING | LETTER_PREPASS)))
+    {
+        printf("ERROR: Options must include 0b001 and only known flags.\n");
+        return false;
+    }
+    return true;
+}
+
+static int validate(int argc, const char *argv[])
+{
+    // validate [size] [options] [count]
+    int size = argc > 2 ? atoi(argv[2]) : 100;
+    unsigned int direction_options = argc > 3 ? parse_direction_options(argv[3]) : 0b00000111;
+    int total_mazes = argc > 4 ? atoi(argv[4]) : 1000;
+
+    if (size < 2 || size > MAZE_MAX_SIZE || total_mazes < 1)
+    {
+        printf("ERROR: Need size 2..%d and count >= 1.\n", MAZE_MAX_SIZE);
+        return 1;
+    }
+
+    if (!check_direction_options(direction_options))
+        return 1;
+
+    const int batch_size = 256;
+    struct maze_walls **mazes = (struct maze_walls **)calloc(batch_size, sizeof(struct maze_walls *));
+    struct maze_validation *results = (struct maze_validation *)calloc(batch_size, sizeof(struct maze_validation));
+
+    struct rng rng;
+    rng_seed(&rng, (unsigned long long)time(NULL));
+
+    double generation_seconds = 0;
+    double validation_seconds = 0;
+    int total_invalid = 0;
+
+    for (int done = 0; done < total_mazes; done += batch_size)
+    {
+        int total_batch = total_mazes - done < batch_size ? total_mazes - done : batch_size;
+        struct timeval start;
+
+        gettimeofday(&start, NULL);
+        for (int i = 0; i < total_batch; i++)
+        {
+            mazes[i] = maze_walls_create(size);
+            randomized_kruskal_walls(false, mazes[i], direction_options, &rng, NULL);
+        }
+        generation_seconds += seconds_since(start);
+
+        gettimeofday(&start, NULL);
+        total_invalid += validate_maze_batch(mazes, total_batch, results);
+        validation_seconds += seconds_since(start);
+
+        for (int i = 0; i < total_batch; i++)
+        {
+            if (!results[i].valid)
+                printf("Maze %d: %s (cell %d)\n", done + i, results[i].error, results[i].bad_cell);
+            maze_walls_free(mazes[i]);
+        }
+    }
+
+    double total_cells = (double)total_mazes * size * size;
+    printf("Validated %d mazes of size %d: %d invalid\n", total_mazes, size, total_invalid);
+    printf("Generation: %.3lf s (%.0lf cells/s)\n", generation_seconds, total_cells / generation_seconds);
+    printf("Validation: %.3lf s (%.0lf cells/s)\n", validation_seconds, total_cells / validation_seconds);
+
+    free(mazes);
+    free(results);
+    return total_invalid ? 1 : 0;
+}
+
+static int record_log(int argc, const char *argv[])
+{
+    // log <size> <options> <file> [seed]
+    if (argc < 5)
+    {
+        printf("Usage: log <size> <options> <file> [seed]\n");
+        return 1;
+    }
+
+    int size = atoi(argv[2]);
+    unsigned int direction_options = parse_direction_options(argv[3]);
+
+    struct rng rng;
+    rng_seed(&rng, argc > 5 ? strtoull(argv[5], NULL, 10) : (unsigned long long)time(NULL));
+
+    struct event_log *log = event_log_create(size, direction_options);
+    struct maze_walls *walls = maze_walls_create(size);
+    struct maze maze1 = randomized_kruskal_walls(false, walls, direction_options, &rng, log);
+
+    FILE *stream = fopen(argv[4], "wb");
+    bool written = stream && event_log_write(log, stream);
+    if (stream)
+        fclose(stream);
+
+    if (written)
+        printf("Wrote %d events from %d passes to %s\n", log->total_events, maze1.total_passes, argv[4]);
+    else
+        printf("ERROR: Can't write %s.\n", argv[4]);
+
+    maze_walls_free(walls);
+    event_log_free(log);
+    return written ? 0 : 1;
+}
+
+static int replay(int argc, const char *argv[])
+{
+    // replay <file> [pass]
+    if (argc < 3)
+    {
+        printf("Usage: replay <file> [pass]\n");
+        return 1;
+    }
+
+    FILE *stream = fopen(argv[2], "rb");
+    struct event_log *log = stream ? event_log_read(stream) : NULL;
+    if (stream)
+        fclose(stream);
+
+    if (log == NULL)
+    {
+        printf("ERROR: Can't read event log %s.\n", argv[2]);
+        return 1;
+    }
+
+    int position = argc > 3 ? event_log_position_at_pass(log, (unsigned int)strtoul(argv[3], NULL, 10)) : log->total_events;
+
+    struct event_replayer *replayer = event_replayer_create(log);
+    event_replayer_seek(replayer, position);
+
+    printf("Event %d of %d\n", replayer->position, log->total_events);
+    fprint_maze_walls(stdout, replayer->walls);
+
+    event_replayer_free(replayer);
+    event_log_free(log);
+    return 0;
+}
+
+static int bench_pages(int argc, const char *argv[])
+{
+    // bench-pages [size] [options] [touch_threads]
+    int size = argc > 2 ? atoi(argv[2]) : 2048;
+    unsigned int direction_options = argc > 3 ? parse_direction_options(argv[3]) : 0b00000001;
+    int touch_threads = argc > 4 ? atoi(argv[4]) : 1;
+
+    if (size < 2 || size > MAZE_MAX_SIZE || touch_threads < 1)
+    {
+        printf("ERROR: Need size 2..%d and touch_threads >= 1.\n", MAZE_MAX_SIZE);
+        return 1;
+    }
+
+    if (!check_direction_options(direction_options))
+        return 1;
+
+    struct maze_allocator allocators[3] = {
+        {"default", MAZE_PAGES_DEFAULT, touch_threads},
+        {"transparent huge pages", MAZE_PAGES_TRANSPARENT, touch_threads},
+        {"explicit huge pages", MAZE_PAGES_EXPLICIT, touch_threads}
+    };
+
+    printf("Size %d (%lld cells), options %u\n", size, (long long)size * size, direction_options);
+
+    for (int i = 0; i < 3; i++)
+    {
+        // Same seed for every allocator, so every run does the same passes
+        struct rng rng;
+        rng_seed(&rng, 2019);
+
+        struct timeval start;
+        gettimeofday(&start, NULL);
+
+        struct maze_walls *walls = maze_walls_create_with(size, MAZE_LAYOUT_LINEAR, &allocators[i]);
+        struct maze maze1 = randomized_kruskal_walls(false, walls, direction_options, &rng, NULL);
+
+        double seconds = seconds_since(start);
+        printf("%-24s %8.3lf s  %12.0lf passes/s\n", allocators[i].name, seconds, maze1.total_passes / seconds);
+
+        maze_walls_free(walls);
+    }
+
+    return 0;
+}
+
+static int world(int argc, const char *argv[])
+{
+    // world <seed> <chunk_size> <x0> <y0> <width> <height> [options] [cache_mb]
+    if (argc < 8)
+    {
+        printf("Usage: world <seed> <chunk_size> <x0> <y0> <width> <height> [options] [cache_mb]\n");
+        return 1;
+    }
+
+    unsigned long long world_seed = strtoull(argv[2], NULL, 10);
+    int chunk_size = atoi(argv[3]);
+    long long x0 = atoll(argv[4]);
+    long long y0 = atoll(argv[5]);
+    int width = atoi(argv[6]);
+    int height = atoi(argv[7]);
+    unsigned int direction_options = argc > 8 ? parse_direction_options(argv[8]) : 0b00000111;
+    size_t cache_bytes = (size_t)(argc > 9 ? atol(argv[9]) : 16) * 1024 * 1024;
+
+    if (chunk_size < 2)
+    {
+        printf("ERROR: Chunk size must be at least 2.\n");
+        return 1;
+    }
+
+    struct chunk_world *world = chunk_world_create(world_seed, chunk_size, direction_options, cache_bytes);
+
+    fprint_chunk_world(stdout, world, x0, y0, width, height);
+    printf("Chunks generated: %ld, cached: %d (%zu bytes)\n", world->total_generated, world->cache->total_entries, world->cache->bytes);
+
+    chunk_world_free(world);
+    return 0;
+}
+
+static int bench_layout(int argc, const char *argv[])
+{
+    // bench-layout [size] [options]
+    int size = argc > 2 ? atoi(argv[2]) : 4096;
+    unsigned int direction_options = argc > 3 ? parse_direction_options(argv[3]) : 0b00000111;
+
+    const char *names[2] = {"linear", "morton"};
+    int layouts[2] = {MAZE_LAYOUT_LINEAR, MAZE_LAYOUT_MORTON};
+
+    FILE *sink = fopen("/dev/null", "w");
+    struct maze_validator *validator = maze_validator_create();
+
+    printf("Size %d (%lld cells), options %u\n", size, (long long)size * size, direction_options);
+    printf("%-8s %12s %12s %12s\n", "layout", "generate s", "validate s", "render s");
+
+    for (int i = 0; i < 2; i++)
+    {
+        // Same seed, so both layouts build the same maze
+        struct rng rng;
+        rng_seed(&rng, 2019);
+
+        struct maze_walls *walls = maze_walls_create_with(size, layouts[i], &default_allocator);
+        struct timeval start;
+
+        gettimeofday(&start, NULL);
+        randomized_kruskal_walls(false, walls, direction_options, &rng, NULL);
+        double generate_seconds = seconds_since(start);
+
+        gettimeofday(&start, NULL);
+        struct maze_validation validation = validate_maze(validator, walls);
+        double validate_seconds = seconds_since(start);
+
+        gettimeofday(&start, NULL);
+        fprint_maze_walls(sink, walls);
+        double render_seconds = seconds_since(start);
+
+        printf("%-8s %12.3lf %12.3lf %12.3lf%s\n", names[i], generate_seconds, validate_seconds, render_seconds,
+               validation.valid ? "" : "  INVALID");
+
+        maze_walls_free(walls);
+    }
+
+    maze_validator_free(validator);
+    fclose(sink);
+    return 0;
+}
+
+static int regenerate(int argc, const char *argv[])
+{
+    // regenerate <size> <options> <x0> <y0> <width> <height> [seed]
+    if (argc < 8)
+    {
+        printf("Usage: regenerate <size> <options> <x0> <y0> <width> <height> [seed]\n");
+        return 1;
+    }
+
+    int size = atoi(argv[2]);
+    unsigned int direction_options = parse_direction_options(argv[3]);
+    struct maze_region region;
+    region.x0 = atoi(argv[4]);
+    region.y0 = atoi(argv[5]);
+    region.width = atoi(argv[6]);
+    region.height = atoi(argv[7]);
+    unsigned long long seed = argc > 8 ? strtoull(argv[8], NULL, 10) : (unsigned long long)time(NULL);
+
+    struct rng rng;
+    rng_seed(&rng, seed);
+
+    struct maze_walls *walls = maze_walls_create(size);
+    struct timeval start;
+
+    gettimeofday(&start, NULL);
+    randomized_kruskal_walls(false, walls, direction_options, &rng, NULL);
+    double generate_seconds = seconds_since(start);
+
+    // Small mazes are printed before and after
+    if (size <= 64)
+        fprint_maze_walls(stdout, walls);
+
+    gettimeofday(&start, NULL);
+    int passes = regenerate_region(walls, region, direction_options, &rng);
+    double region_seconds = seconds_since(start);
+
+    if (size <= 64)
+        fprint_maze_walls(stdout, walls);
+
+    struct maze_validator *validator = maze_validator_create();
+    struct maze_validation validation = validate_maze(validator, walls);
+
+    printf("Whole maze: %.3lf s; region %dx%d: %.6lf s, %d passes; %s\n",
+           generate_seconds, region.width, region.height, region_seconds, passes,
+           validation.valid ? "still perfect" : validation.error);
+
+    maze_validator_free(validator);
+    maze_walls_free(walls);
+    return validation.valid ? 0 : 1;
+}
+
+static int bench_engines(int argc, const char *argv[])
+{
+    // bench-engines [size] [options] [seed]
+    int size = argc > 2 ? atoi(argv[2]) : 1024;
+    unsigned int direction_options = argc > 3 ? parse_direction_options(argv[3]) : 0b00000111;
+    unsigned long long seed = argc > 4 ? strtoull(argv[4], NULL, 10) : 2019;
+
+    if (size < 2 || size > MAZE_MAX_SIZE)
+    {
+        printf("ERROR: Need size 2..%d.\n", MAZE_MAX_SIZE);
+        return 1;
+    }
+
+    if (!check_direction_options(direction_options))
+        return 1;
+
+    struct maze_validator *validator = maze_validator_create();
+
+    printf("Size %d (%lld cells), options %u\n", size, (long long)size * size, direction_options);
+    printf("%-12s %10s %14s %10s  %s\n", "engine", "seconds", "cells/s", "dead ends", "cost");
+
+    for (int i = 0; i < total_maze_engines; i++)
+    {
+        const struct maze_engine *engine = &maze_engines[i];
+        struct maze_walls *walls = maze_walls_create(size);
+
+        struct timeval start;
+        gettimeofday(&start, NULL);
+        maze_engine_generate(engine, walls, direction_options, seed);
+        double seconds = seconds_since(start);
+
+        struct maze_validation validation = validate_maze(validator, walls);
+
+        struct maze degrees;
+        count_degrees(&degrees, walls);
+
+        printf("%-12s %10.3lf %14.0lf %9.1lf%%  %s%s\n", engine->name, seconds, (double)size * size / seconds,
+               100.0 * degrees.total_deg1_nodes / ((double)size * size), engine->cost,
+               validation.valid ? "" : "  INVALID");
+
+        maze_walls_free(walls);
+    }
+
+    maze_validator_free(validator);
+    return 0;
+}
+
+static int search(int argc, const char *argv[])
+{
+    // search <size> <options> <count> <condition>... [--from seed] [--limit seeds] [--threads N]
+    if (argc < 5)
+    {
+        printf("Usage: search <size> <options> <count> <condition>... [--from seed] [--limit seeds] [--threads N]\n");
+        printf("Conditions: <metric><op><value> or <metric>=<low>..<high>, op one of < <= = >= >\n");
+        printf("Metrics:");
+        for (int i = 0; i < TOTAL_SEARCH_METRICS; i++)
+            printf(" %s", seed_metric_names[i]);
+        printf("\n");
+        return 1;
+    }
+
+    int size = atoi(argv[2]);
+    unsigned int direction_options = parse_direction_options(argv[3]);
+    int wanted = atoi(argv[4]);
+    unsigned long long first_seed = 0;
+    long long total_seeds = 0;
+    int total_threads = 1;
+
+    struct seed_predicate predicate;
+    seed_predicate_init(&predicate);
+
+    for (int i = 5; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--from") == 0 && i + 1 < argc) {
+            first_seed = strtoull(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--limit") == 0 && i + 1 < argc) {
+            total_seeds = atoll(argv[++i]);
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            total_threads = atoi(argv[++i]);
+        } else if (!seed_predicate_add(&predicate, argv[i])) {
+            printf("ERROR: Bad condition %s.\n", argv[i]);
+            return 1;
+        }
+    }
+
+    if (size < 2 || size > MAZE_MAX_SIZE || wanted < 1)
+    {
+        printf("ERROR: Need size 2..%d and count >= 1.\n", MAZE_MAX_SIZE);
+        return 1;
+    }
+
+    if (!check_direction_options(direction_options))
+        return 1;
+
+    struct seed_match *matches = (struct seed_match *)calloc(wanted, sizeof(struct seed_match));
+    struct seed_search_totals totals;
+
+    struct timeval start;
+    gettimeofday(&start, NULL);
+    int total_matches = seed_search(size, direction_options, &predicate, first_seed, total_seeds, wanted,
+                                    total_threads, matches, &totals);
+    double seconds = seconds_since(start);
+
+    for (int i = 0; i < total_matches; i++)
+        fprint_seed_match(stdout, &matches[i]);
+
+    printf("%d of %d found; %lld seeds scanned, %lld abandoned early, in %.3lf s (%.0lf seeds/s)\n",
+           total_matches, wanted, totals.total_scanned, totals.total_abandoned, seconds, totals.total_scanned / seconds);
+
+    free(matches);
+    return total_matches == wanted ? 0 : 1;
+}
+
+static int stats_shard(int argc, const char *argv[])
+{
+    // stats-shard <size> <options> <seed> <first_trial> <trials> <file>
+    if (argc < 8)
+    {
+        printf("Usage: stats-shard <size> <options> <seed> <first_trial> <trials> <file>\n");
+        return 1;
+    }
+
+    int size = atoi(argv[2]);
+    long long first_trial = atoll(argv[5]);
+    long long total_trials = atoll(argv[6]);
+
+    if (size < 2 || size > MAZE_MAX_SIZE || first_trial < 0 || total_trials < 0)
+    {
+        printf("ERROR: Need size 2..%d and a trial range of non-negative numbers.\n", MAZE_MAX_SIZE);
+        return 1;
+    }
+
+    unsigned int direction_options = parse_direction_options(argv[3]);
+    if (!check_direction_options(direction_options))
+        return 1;
+
+    struct stats_shard *shard = stats_shard_create(size, direction_options, strtoull(argv[4], NULL, 10));
+    if (shard == NULL || !stats_shard_run(shard, first_trial, total_trials))
+    {
+        printf("ERROR: Can't run trials [%lld, %lld + %lld).\n", first_trial, first_trial, total_trials);
+        return 1;
+    }
+
+    FILE *file = fopen(argv[7], "wb");
+    if (file == NULL || !stats_shard_write(shard, file))
+    {
+        printf("ERROR: Can't write %s.\n", argv[7]);
+        return 1;
+    }
+    fclose(file);
+
+    fprint_stats_shard(stdout, shard);
+    stats_shard_free(shard);
+    return 0;
+}
+
+static int stats_merge(int argc, const char *argv[])
+{
+    // stats-merge <out_file> <shard_file>...
+    if (argc < 4)
+    {
+        printf("Usage: stats-merge <out_file> <shard_file>...\n");
+        return 1;
+    }
+
+    struct stats_shard *merged = NULL;
+
+    for (int i = 3; i < argc; i++)
+    {
+        FILE *file = fopen(argv[i], "rb");
+        struct stats_shard *shard = file ? stats_shard_read(file) : NULL;
+        if (file)
+            fclose(file);
+
+        if (shard == NULL)
+        {
+            printf("ERROR: Can't read %s.\n", argv[i]);
+            stats_shard_free(merged);
+            return 1;
+        }
+
+        if (merged == NULL)
+        {
+            merged = shard;
+            continue;
+        }
+
+        if (!stats_shard_merge(merged, shard))
+        {
+            printf("ERROR: %s is from a different run (size, options or seed) or repeats trials already merged.\n", argv[i]);
+            stats_shard_free(shard);
+            stats_shard_free(merged);
+            return 1;
+        }
+        stats_shard_free(shard);
+    }
+
+    FILE *file = fopen(argv[2], "wb");
+    if (file == NULL || !stats_shard_write(merged, file))
+    {
+        printf("ERROR: Can't write %s.\n", argv[2]);
+        return 1;
+    }
+    fclose(file);
+
+    fprint_stats_shard(stdout, merged);
+    fprint_stats_shard_gaps(stdout, merged);
+    stats_shard_free(merged);
+    return 0;
+}
+
+static int stats_fork_run(int argc, const char *argv[])
+{
+    // stats-fork <workers> <size> <options> <seed> <trials> [directory]
+    if (argc < 7)
+    {
+        printf("Usage: stats-fork <workers> <size> <options> <seed> <trials> [directory]\n");
+        return 1;
+    }
+
+    int total_workers = atoi(argv[2]);
+    int size = atoi(argv[3]);
+    unsigned int direction_options = parse_direction_options(argv[4]);
+    long long total_trials = atoll(argv[6]);
+    if (total_workers < 1 || size < 2 || size > MAZE_MAX_SIZE || total_trials < 0)
+    {
+        printf("ERROR: Need at least one worker, size 2..%d and a non-negative number of trials.\n", MAZE_MAX_SIZE);
+        return 1;
+    }
+
+    if (!check_direction_options(direction_options))
+        return 1;
+
+    struct timeval start;
+    gettimeofday(&start, NULL);
+
+    struct stats_shard *result = stats_fork(total_workers, size, direction_options,
+                                            strtoull(argv[5], NULL, 10), total_trials, argc > 7 ? argv[7] : "/tmp");
+    if (result == NULL)
+        return 1;
+
+    fprint_stats_shard(stdout, result);
+    printf("Workers: %d, %.3lf s\n", total_workers, seconds_since(start));
+
+    stats_shard_free(result);
+    return 0;
+}
+
+// Splits "a,b,c" into up to capacity values; returns how many
+static int parse_list(const char *text, long long *values, int capacity, bool options)
+{
+    int total = 0;
+    char *copy = strdup(text);
+
+    for (char *item = strtok(copy, ","); item != NULL && total < capacity; item = strtok(NULL, ","))
+        values[total++] = options ? (long long)parse_direction_options(item) : atoll(item);
+
+    free(copy);
+    return total;
+}
+
+static int sweep(int argc, const char *argv[])
+{
+    // sweep <directory> <sizes> <options> <trials> [--seed S] [--threads N]
+    if (argc < 6)
+    {
+        printf("Usage: sweep <directory> <sizes> <options> <trials> [--seed S] [--threads N]\n");
+        printf("Lists are comma-separated, e.g. sweep runs/a 10,20,50 0b001,0b011,0b111 100000\n");
+        return 1;
+    }
+
+    long long sizes[256], options[256], trials[256];
+    int total_sizes = parse_list(argv[3], sizes, 256, false);
+    int total_options = parse_list(argv[4], options, 256, true);
+    int total_trial_counts = parse_list(argv[5], trials, 256, false);
+    unsigned long long seed = 2019;
+    int total_threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+
+    for (int i = 6; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = strtoull(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            total_threads = atoi(argv[++i]);
+        } else {
+            printf("ERROR: Unknown argument %s.\n", argv[i]);
+            return 1;
+        }
+    }
+
+    // Grid order: size, then options, then trials
+    int total_configs = total_sizes * total_options * total_trial_counts;
+    struct sweep_config *configs = (struct sweep_config *)calloc(total_configs + 1, sizeof(struct sweep_config));
+
+    for (int s = 0; s < total_sizes; s++)
+    {
+        for (int o = 0; o < total_options; o++)
+        {
+            for (int t = 0; t < total_trial_counts; t++)
+            {
+                struct sweep_config *config = &configs[(s * total_options + o) * total_trial_counts + t];
+                config->size = (int)sizes[s];
+                config->direction_options = (unsigned int)options[o];
+                config->total_trials = trials[t];
+
+                if (config->size < 2 || config->size > MAZE_MAX_SIZE || config->total_trials < 1)
+                {
+                    printf("ERROR: Need sizes 2..%d and trials >= 1.\n", MAZE_MAX_SIZE);
+                    free(configs);
+                    return 1;
+                }
+
+                if (!check_direction_options(config->direction_options))
+                {
+                    free(configs);
+                    return 1;
+                }
+            }
+        }
+    }
+
+    bool finished = sweep_run(configs, total_configs, seed, total_threads, argv[2]);
+    free(configs);
+
+    if (finished)
+        printf("Results: %s/%s\n", argv[2], SWEEP_RESULTS);
+    return finished ? 0 : 1;
+}
+
+static int masked(int argc, const char *argv[])
+{
+    // masked <width>x<height> | <mask file> [options] [seed]
+    if (argc < 3)
+    {
+        printf("Usage: masked <width>x<height> | <mask file> [options] [seed]\n");
+        printf("Mask files have one line per row, '#' for a masked cell.\n");
+        return 1;
+    }
+
+    unsigned int direction_options = argc > 3 ? parse_direction_options(argv[3]) : 0b00000111;
+    unsigned long long seed = argc > 4 ? strtoull(argv[4], NULL, 10) : (unsigned long long)time(NULL);
+
+    struct maze_mask *mask;
+    int width;
+    int height;
+    if (sscanf(argv[2], "%dx%d", &width, &height) == 2) {
+        if (width < 1 || height < 1 || (long long)width * height > INT_MAX)
+        {
+            printf("ERROR: Bad grid %s.\n", argv[2]);
+            return 1;
+        }
+        mask = maze_mask_create(width, height);
+    } else {
+        FILE *file = fopen(argv[2], "r");
+        if (file == NULL)
+        {
+            printf("ERROR: Can't open %s.\n", argv[2]);
+            return 1;
+        }
+        mask = maze_mask_read(file);
+        fclose(file);
+
+        if (mask == NULL)
+        {
+            printf("ERROR: %s has no rows or too many cells.\n", argv[2]);
+            return 1;
+        }
+    }
+
+    if (mask->total_live < 1 || !maze_mask_connected(mask))
+    {
+        printf("ERROR: The live cells of the mask are not connected.\n");
+        maze_mask_free(mask);
+        return 1;
+    }
+
+    struct rng rng;
+    rng_seed(&rng, seed);
+
+    struct maze_walls *walls = maze_walls_create_rect(mask->width, mask->height);
+    struct timeval start;
+
+    gettimeofday(&start, NULL);
+    struct maze result = masked_kruskal_walls(walls, mask, direction_options, &rng, NULL);
+    double seconds = seconds_since(start);
+
+    struct maze_validator *validator = maze_validator_create();
+    struct maze_validation validation = validate_maze_masked(validator, walls, mask);
+
+    if (mask->width <= 64 && mask->height <= 64)
+        fprint_masked_maze_walls(stdout, walls, mask);
+
+    printf("%dx%d, %d live cells; %d passes, %d failed; degrees %d/%d/%d/%d; %.6lf s; %s\n",
+           mask->width, mask->height, mask->total_live, result.total_passes, result.total_failed_passes,
+           result.total_deg1_nodes, result.total_deg2_nodes, result.total_deg3_nodes, result.total_deg4_nodes,
+           seconds, validation.valid ? "perfect" : validation.error);
+
+    maze_validator_free(validator);
+    maze_walls_free(walls);
+    maze_mask_free(mask);
+    return validation.valid ? 0 : 1;
+}
+
+static int archive(int argc, const char *argv[])
+{
+    // archive <size> <options> <count> <file> [seed] [threads] [mazes_per_block]
+    if (argc < 6)
+    {
+        printf("Usage: archive <size> <options> <count> <file> [seed] [threads] [mazes_per_block]\n");
+        return 1;
+    }
+
+    int size = atoi(argv[2]);
+    unsigned int direction_options = parse_direction_options(argv[3]);
+    long long total_mazes = atoll(argv[4]);
+    unsigned long long seed = argc > 6 ? strtoull(argv[6], NULL, 10) : (unsigned long long)time(NULL);
+    int total_threads = argc > 7 ? atoi(argv[7]) : 1;
+    int mazes_per_block = argc > 8 ? atoi(argv[8]) : MAZE_ARCHIVE_BLOCK_MAZES;
+
+    // Before the file is opened, so bad arguments don't clobber it
+    if (size < 2 || size > MAZE_MAX_SIZE || total_mazes < 1 || total_threads < 1 || mazes_per_block < 1)
+    {
+        printf("ERROR: Need size 2..%d, count >= 1, threads >= 1 and mazes_per_block >= 1.\n", MAZE_MAX_SIZE);
+        return 1;
+    }
+
+    if (!check_direction_options(direction_options))
+        return 1;
+
+    FILE *file = fopen(argv[5], "wb");
+    struct timeval start;
+    gettimeofday(&start, NULL);
+
+    bool written = file != NULL
+        && maze_archive_generate(file, size, direction_options, seed, total_mazes, mazes_per_block, total_threads);
+    double seconds = seconds_since(start);
+
+    if (file == NULL || fclose(file) != 0 || !written)
+    {
+        printf("ERROR: Can't write %s.\n", argv[5]);
+        return 1;
+    }
+
+    // The index ends the file
+    file = fopen(argv[5], "rb");
+    fseek(file, 0, SEEK_END);
+    long bytes = ftell(file);
+    fclose(file);
+
+    double cells = (double)total_mazes * size * size;
+    printf("%lld mazes of size %d (seed %llu) in %.3lf s: %ld bytes, %.4lf bits/cell\n",
+           total_mazes, size, seed, seconds, bytes, 8.0 * bytes / cells);
+    return 0;
+}
+
+static int archive_read(int argc, const char *argv[])
+{
+    // archive-read <file> <maze>
+    if (argc < 4)
+    {
+        printf("Usage: archive-read <file> <maze>\n");
+        return 1;
+    }
+
+    FILE *file = fopen(argv[2], "rb");
+    struct maze_archive *archive = file ? maze_archive_open(file) : NULL;
+    if (archive == NULL)
+    {
+        printf("ERROR: Can't open %s.\n", argv[2]);
+        return 1;
+    }
+
+    struct maze_walls *walls = maze_walls_create(archive->size);
+    bool valid = maze_archive_read(archive, atoll(argv[3]), walls->cells);
+
+    if (valid)
+        fprint_maze_walls(stdout, walls);
+    else
+        printf("ERROR: Can't read maze %s of %lld.\n", argv[3], archive->total_mazes);
+
+    maze_walls_free(walls);
+    maze_archive_close(archive);
+    fclose(file);
+    return valid ? 0 : 1;
+}
+
+static int archive_bench(int argc, const char *argv[])
+{
+    // archive-bench <file> [threads]
+    if (argc < 3)
+    {
+        printf("Usage: archive-bench <file> [threads]\n");
+        return 1;
+    }
+
+    int total_threads = argc > 3 ? atoi(argv[3]) : 1;
+
+    FILE *file = fopen(argv[2], "rb");
+    struct maze_archive *archive = file ? maze_archive_open(file) : NULL;
+    if (archive == NULL)
+    {
+        printf("ERROR: Can't open %s.\n", argv[2]);
+        return 1;
+    }
+
+    const int size = archive->size;
+    const size_t maze_bytes = (size_t)size * size;
+    unsigned char *cells = (unsigned char *)malloc(maze_bytes * archive->total_mazes + 1);
+    if (cells == NULL)
+    {
+        printf("ERROR: Can't allocate %lld mazes of size %d.\n", archive->total_mazes, size);
+        maze_archive_close(archive);
+        fclose(file);
+        return 1;
+    }
+
+    struct timeval start;
+    gettimeofday(&start, NULL);
+    bool valid = maze_archive_read_all(archive, cells, total_threads);
+    double seconds = seconds_since(start);
+
+    // Every decoded maze must still be perfect
+    long long invalid_mazes = 0;
+    struct maze_validator *validator = maze_validator_create();
+    struct maze_walls *walls = maze_walls_create(size);
+
+    for (long long i = 0; valid && i < archive->total_mazes; i++)
+    {
+        memcpy(walls->cells, cells + maze_bytes * i, maze_bytes);
+        if (!validate_maze(validator, walls).valid)
+            invalid_mazes++;
+    }
+
+    double total_cells = (double)archive->total_mazes * maze_bytes;
+    double archive_bytes = (double)archive->offsets[archive->total_blocks] + 8.0 * (archive->total_blocks + 1);
+
+    printf("%lld mazes of size %d in %lld blocks: %.4lf bits/cell (bit-packed walls: 2)\n",
+           archive->total_mazes, size, archive->total_blocks, 8.0 * archive_bytes / total_cells);
+    printf("Decoded on %d threads in %.3lf s: %.0lf mazes/s, %.1lf M cells/s; %s\n",
+           total_threads, seconds, archive->total_mazes / seconds, total_cells / seconds / 1e6,
+           !valid ? "CORRUPT" : invalid_mazes ? "INVALID MAZES" : "all perfect");
+
+    maze_walls_free(walls);
+    maze_validator_free(validator);
+    free(cells);
+    maze_archive_close(archive);
+    fclose(file);
+    return valid && invalid_mazes == 0 ? 0 : 1;
+}
 
 int main(int argc, const char *argv[])
 {
+    if (argc > 1 && strcmp(argv[1], "serve") == 0)
+        return serve(argc, argv);
+    if (argc > 1 && strcmp(argv[1], "validate") == 0)
+        return validate(argc, argv);
+    if (argc > 1 && strcmp(argv[1], "log") == 0)
+        return record_log(argc, argv);
+    if (argc > 1 && strcmp(argv[1], "replay") == 0)
+        return replay(argc, argv);
+    if (argc > 1 && strcmp(argv[1], "bench-pages") == 0)
+        return bench_pages(argc, argv);
+    if (argc > 1 && strcmp(argv[1], "world") == 0)
+        return world(argc, argv);
+    if (argc > 1 && strcmp(argv[1], "bench-layout") == 0)
+        return bench_layout(argc, argv);
+    if (argc > 1 && strcmp(argv[1], "bench-engines") == 0)
+        return bench_engines(argc, argv);
+    if (argc > 1 && strcmp(argv[1], "regenerate") == 0)
+        return regenerate(argc, argv);
+    if (argc > 1 && strcmp(argv[1], "stats-shard") == 0)
+        return stats_shard(argc, argv);
+    if (argc > 1 && strcmp(argv[1], "stats-merge") == 0)
+        return stats_merge(argc, argv);
+    if (argc > 1 && strcmp(argv[1], "stats-fork") == 0)
+        return stats_fork_run(argc, argv);
+    if (argc > 1 && strcmp(argv[1], "archive") == 0)
+        return archive(argc, argv);
+    if (argc > 1 && strcmp(argv[1], "archive-read") == 0)
+        return archive_read(argc, argv);
+    if (argc > 1 && strcmp(argv[1], "archive-bench") == 0)
+        return archive_bench(argc, argv);
+    if (argc > 1 && strcmp(argv[1], "search") == 0)
+        return search(argc, argv);
+    if (argc > 1 && strcmp(argv[1], "sweep") == 0)
+        return sweep(argc, argv);
+    if (argc > 1 && strcmp(argv[1], "masked") == 0)
+        return masked(argc, argv);
+    if (argc > 1 && strcmp(argv[1], "stats") == 0)
+    {
+        srand((unsigned)time(NULL));
+        unsigned int direction_options = argc > 2 ? parse_direction_options(argv[2]) : 0b00000001;
+        bool batch = argc > 3 && strcmp(argv[3], "batch") == 0;
+        stats_with(direction_options, batch ? STATS_BATCH : STATS_SERIAL);
+        return 0;
+    }
+
     printf("Kruskal's Maze Generation!\n");
     // Initialize randomizer
     srand((unsigned)time(NULL));
@@ -43,6 +1016,8 @@ int main(int argc, const char *argv[])
 //    stats(0b00000011);
 //    printf("== Standard + Prioritized S ==\n");
 //    stats(0b00000101);
+//    printf("== Standard + Prioritized S, uniform sampling ==\n");
+//    stats(0b00001101);
     return 0;
 }
 
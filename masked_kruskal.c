@@ -0,0 +1,211 @@
+//
+//  masked_kruskal.c
+//  kruskal-maze-generation-c
+//
+//  Created by Ezzat Chamudi on 10/19/26.
+//  Copyright © 2026 Ezzat Chamudi. All rights reserved.
+//  License: Apache-2.0
+//
+
+#include "masked_kruskal.h"
+
+#include "letter_prepass.h"
+#include "print_maze.h"
+#include "randomized_kruskal.h"
+
+// Like room_window(), except that masked cells take the middle cell's room.
+// legal_directions() then turns down every move that touches one, exactly as
+// it does for a move crossing the border.
+static void masked_window(int window[3][3], int *rooms, const struct maze_walls *walls, const struct maze_mask *mask,
+                          struct coordinate node_mid)
+{
+    int middle_room = find_room(rooms, maze_cell_index(walls, node_mid.x, node_mid.y));
+
+    for (int dx = -1; dx <= 1; dx++)
+    {
+        for (int dy = -1; dy <= 1; dy++)
+        {
+            int x = (int)node_mid.x + dx;
+            int y = (int)node_mid.y + dy;
+            window[dx + 1][dy + 1] = maze_mask_live(mask, x, y) ? find_room(rooms, maze_cell_index(walls, x, y)) : middle_room;
+        }
+    }
+}
+
+static void merge_rooms(int *rooms, const struct maze_walls *walls, const struct coordinate *selected_nodes, int total_selected_nodes)
+{
+    int target_room = find_room(rooms, maze_cell_index(walls, selected_nodes[0].x, selected_nodes[0].y));
+
+    for (int i = 1; i < total_selected_nodes; i++)
+    {
+        int room_id = find_room(rooms, maze_cell_index(walls, selected_nodes[i].x, selected_nodes[i].y));
+        rooms[room_id] = target_room;
+    }
+}
+
+struct maze masked_kruskal_walls(struct maze_walls *walls, const struct maze_mask *mask, unsigned int direction_options,
+                                 struct rng *rng, struct event_log *log)
+{
+    struct maze result;
+
+    if (walls->width != mask->width || walls->height != mask->height || walls->layout != MAZE_LAYOUT_LINEAR)
+    {
+        printf("ERROR: A %d x %d mask needs a linear %d x %d maze.\n", mask->width, mask->height, mask->width, mask->height);
+        exit(1);
+    }
+
+    // masked_window() already shuts the moves past the edges
+    const int side = mask->width > mask->height ? mask->width : mask->height;
+
+    if (mask->total_live < 1 || !maze_mask_connected(mask))
+    {
+        printf("ERROR: The live cells of the mask are not connected.\n");
+        exit(1);
+    }
+
+    int *rooms = (int *)maze_allocate(walls->allocator, (size_t)walls->total_cells * sizeof(int));
+    struct coordinate *live_cells = (struct coordinate *)malloc(mask->total_live * sizeof(struct coordinate));
+
+    if (rooms == NULL || live_cells == NULL)
+    {
+        printf("ERROR: Can't allocate rooms for a %d x %d maze.\n", mask->width, mask->height);
+        exit(1);
+    }
+
+    for (int i = 0; i < walls->total_cells; i++)
+        rooms[i] = i;
+
+    // Passes draw from these
+    int total_live = 0;
+    for (int x = 0; x < mask->width; x++)
+    {
+        for (int y = 0; y < mask->height; y++)
+        {
+            if (maze_mask_live(mask, x, y))
+            {
+                live_cells[total_live].x = x;
+                live_cells[total_live].y = y;
+                total_live++;
+            }
+        }
+    }
+
+    int pass_number = 0;
+    int failed_pass_number = 0;
+    int rooms_counter = total_live;
+    int fail_streak = 0;
+    const long long max_fail_streak = (long long)total_live * 10;
+
+    if ((direction_options & LETTER_PREPASS) && (direction_options & ENABLE_LETTERS))
+    {
+        int total_centers;
+        struct coordinate *centers = letter_prepass_rect(mask->width, mask->height, rng, &total_centers);
+
+        for (int i = 0; i < total_centers; i++)
+        {
+            struct coordinate selected_nodes[9];
+            direction_nodes(selected_nodes, centers[i], LETTER_S);
+
+            bool all_live = true;
+            for (int j = 0; j < 9 && all_live; j++)
+                all_live = maze_mask_live(mask, selected_nodes[j].x, selected_nodes[j].y);
+            if (!all_live)
+                continue;
+
+            pass_number++;
+            link_direction_nodes(walls, selected_nodes, LETTER_S);
+
+            if (log)
+                event_log_append(log, maze_cell_index(walls, centers[i].x, centers[i].y), pass_number, LETTER_S);
+
+            merge_rooms(rooms, walls, selected_nodes, 9);
+            rooms_counter -= 8;
+        }
+
+        free(centers);
+    }
+
+    while (rooms_counter > 1)
+    {
+        pass_number++;
+
+        struct coordinate node_mid = live_cells[rng_range(rng, total_live)];
+
+        int window[3][3];
+        masked_window(window, rooms, walls, mask, node_mid);
+
+        unsigned char directions[TOTAL_DIRECTIONS + 1];
+        int total_available_directions = legal_directions(directions, node_mid.x, node_mid.y, side, direction_options, window);
+
+        if (total_available_directions == 0)
+        {
+            failed_pass_number++;
+            fail_streak++;
+
+            if (fail_streak > max_fail_streak) {
+                printf("ERROR: Too much fail streak. Can't combine all rooms using legal directions.\n");
+                fprint_masked_maze_walls(stdout, walls, mask);
+                exit(1);
+            }
+
+            continue;
+        }
+        fail_streak = 0;
+
+        // Letter-S first, like the general engine
+        int selected_direction;
+        if (directions[total_available_directions] == LETTER_S)
+            selected_direction = LETTER_S;
+        else
+            selected_direction = directions[rng_range(rng, total_available_directions) + 1];
+
+        struct coordinate selected_nodes[9];
+        int total_selected_nodes = direction_nodes(selected_nodes, node_mid, selected_direction);
+
+        link_direction_nodes(walls, selected_nodes, selected_direction);
+
+        if (log)
+            event_log_append(log, maze_cell_index(walls, node_mid.x, node_mid.y), pass_number, selected_direction);
+
+        merge_rooms(rooms, walls, selected_nodes, total_selected_nodes);
+        rooms_counter -= total_selected_nodes - 1;
+    }
+
+    // count_degrees() would stop at the masked cells
+    result.total_deg1_nodes = 0;
+    result.total_deg2_nodes = 0;
+    result.total_deg3_nodes = 0;
+    result.total_deg4_nodes = 0;
+
+    for (int i = 0; i < total_live; i++)
+    {
+        switch (maze_walls_degree(walls, maze_cell_index(walls, live_cells[i].x, live_cells[i].y)))
+        {
+        case 1:
+            result.total_deg1_nodes++;
+            break;
+        case 2:
+            result.total_deg2_nodes++;
+            break;
+        case 3:
+            result.total_deg3_nodes++;
+            break;
+        case 4:
+            result.total_deg4_nodes++;
+            break;
+        default:
+            break;
+        }
+    }
+
+    maze_release(walls->allocator, rooms, (size_t)walls->total_cells * sizeof(int));
+    free(live_cells);
+
+    result.total_passes = pass_number;
+    result.total_failed_passes = failed_pass_number;
+    result.size = walls->size;
+    result.graph = NULL;
+    result.total_nodes = total_live;
+
+    return result;
+}
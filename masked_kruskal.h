@@ -0,0 +1,36 @@
+//
+//  masked_kruskal.h
+//  kruskal-maze-generation-c
+//
+//  Created by Ezzat Chamudi on 10/19/26.
+//  Copyright © 2026 Ezzat Chamudi. All rights reserved.
+//  License: Apache-2.0
+//
+
+#ifndef masked_kruskal_h
+#define masked_kruskal_h
+
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include "definitions.h"
+#include "event_log.h"
+#include "maze_mask.h"
+#include "maze_walls.h"
+#include "rng.h"
+
+// Randomized Kruskal over the live cells of mask only, into walls of the
+// mask's width and height (maze_walls_create_rect()). The result is a
+// spanning tree of the live cells, and masked cells keep no passages.
+// Moves are legal by the usual rules with masked cells treated like the
+// border, and passes pick among live cells only, so masking half of a grid
+// doesn't double the failed passes. The degree counts in the result cover
+// live cells, and the rooms cover the mask's cells and nothing more. Event
+// log cells are maze_cell_index() values, x * height + y.
+//
+// With LETTER_PREPASS, pre-pass shapes that would touch a masked cell are
+// skipped. UNIFORM_SAMPLING is not supported and is ignored.
+extern struct maze masked_kruskal_walls(struct maze_walls *walls, const struct maze_mask *mask, unsigned int direction_options,
+                                        struct rng *rng, struct event_log *log);
+
+#endif /* masked_kruskal_h */
@@ -0,0 +1,138 @@
+//
+//  maze_allocator.c
+//  kruskal-maze-generation-c
+//
+//  Created by Ezzat Chamudi on 10/19/26.
+//  Copyright © 2026 Ezzat Chamudi. All rights reserved.
+//  License: Apache-2.0
+//
+
+#include "maze_allocator.h"
+
+#include <stdbool.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#define HUGE_PAGE_SIZE (2 * 1024 * 1024)
+
+// Mapped buffers start with a header so release knows the mapping length
+#define MAPPING_HEADER 64
+
+const struct maze_allocator default_allocator = {"default", MAZE_PAGES_DEFAULT, 1};
+
+struct touch_stripe {
+    unsigned char *start;
+    size_t bytes;
+    bool threaded;
+};
+
+static void *touch_pages(void *data)
+{
+    struct touch_stripe *stripe = (struct touch_stripe *)data;
+    long page_size = sysconf(_SC_PAGESIZE);
+
+    for (size_t offset = 0; offset < stripe->bytes; offset += page_size)
+        stripe->start[offset] = 0;
+
+    return NULL;
+}
+
+static void first_touch(unsigned char *memory, size_t bytes, int total_threads)
+{
+    pthread_t *threads = (pthread_t *)calloc(total_threads, sizeof(pthread_t));
+    struct touch_stripe *stripes = (struct touch_stripe *)calloc(total_threads, sizeof(struct touch_stripe));
+    size_t stripe_bytes = (bytes + total_threads - 1) / total_threads;
+
+    for (int i = 0; i < total_threads; i++)
+    {
+        size_t begin = stripe_bytes * i < bytes ? stripe_bytes * i : bytes;
+        size_t end = begin + stripe_bytes < bytes ? begin + stripe_bytes : bytes;
+
+        stripes[i].start = memory + begin;
+        stripes[i].bytes = end - begin;
+        stripes[i].threaded = pthread_create(&threads[i], NULL, touch_pages, &stripes[i]) == 0;
+
+        // Touched from here instead; only the page placement differs
+        if (!stripes[i].threaded)
+            touch_pages(&stripes[i]);
+    }
+
+    for (int i = 0; i < total_threads; i++)
+    {
+        if (stripes[i].threaded)
+            pthread_join(threads[i], NULL);
+    }
+
+    free(threads);
+    free(stripes);
+}
+
+static void *map_pages(size_t length, int pages)
+{
+    void *mapping = MAP_FAILED;
+
+#ifdef MAP_HUGETLB
+    if (pages == MAZE_PAGES_EXPLICIT)
+        mapping = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+#endif
+
+    if (mapping == MAP_FAILED)
+    {
+        mapping = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+#ifdef MADV_HUGEPAGE
+        if (mapping != MAP_FAILED)
+            madvise(mapping, length, MADV_HUGEPAGE);
+#endif
+    }
+
+    return mapping == MAP_FAILED ? NULL : mapping;
+}
+
+void *maze_allocate(const struct maze_allocator *allocator, size_t bytes)
+{
+    if (allocator == NULL || allocator->pages == MAZE_PAGES_DEFAULT)
+    {
+        void *memory = calloc(bytes ? bytes : 1, 1);
+
+        if (memory && allocator && allocator->touch_threads > 1)
+            first_touch((unsigned char *)memory, bytes, allocator->touch_threads);
+
+        return memory;
+    }
+
+    // Whole huge pages, anonymous mappings come zeroed
+    size_t length = (bytes + MAPPING_HEADER + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+    unsigned char *mapping = (unsigned char *)map_pages(length, allocator->pages);
+
+    if (mapping == NULL)
+        return NULL;
+
+    memcpy(mapping, &length, sizeof(length));
+
+    if (allocator->touch_threads > 1)
+        first_touch(mapping, length, allocator->touch_threads);
+
+    return mapping + MAPPING_HEADER;
+}
+
+void maze_release(const struct maze_allocator *allocator, void *memory, size_t bytes)
+{
+    (void)bytes;
+
+    if (memory == NULL)
+        return;
+
+    if (allocator == NULL || allocator->pages == MAZE_PAGES_DEFAULT)
+    {
+        free(memory);
+        return;
+    }
+
+    unsigned char *mapping = (unsigned char *)memory - MAPPING_HEADER;
+    size_t length;
+    memcpy(&length, mapping, sizeof(length));
+    munmap(mapping, length);
+}
@@ -0,0 +1,38 @@
+//
+//  maze_allocator.h
+//  kruskal-maze-generation-c
+//
+//  Created by Ezzat Chamudi on 10/19/26.
+//  Copyright © 2026 Ezzat Chamudi. All rights reserved.
+//  License: Apache-2.0
+//
+
+#ifndef maze_allocator_h
+#define maze_allocator_h
+
+#include <stdlib.h>
+
+#define MAZE_PAGES_DEFAULT     0
+#define MAZE_PAGES_TRANSPARENT 1
+#define MAZE_PAGES_EXPLICIT    2
+
+// Where the big per-cell buffers (passages, rooms) come from. Huge pages cut
+// TLB misses on giant grids, where every pass touches random cells. Explicit
+// huge pages fall back to transparent ones, and those to normal pages,
+// without failing.
+//
+// With touch_threads > 1 the pages are first written by that many threads,
+// one contiguous stripe each, so first-touch NUMA placement puts every stripe
+// on the node of the thread that works on it.
+struct maze_allocator {
+    const char *name;
+    int pages;
+    int touch_threads;
+};
+
+extern const struct maze_allocator default_allocator;
+
+extern void *maze_allocate(const struct maze_allocator *allocator, size_t bytes);
+extern void maze_release(const struct maze_allocator *allocator, void *memory, size_t bytes);
+
+#endif /* maze_allocator_h */
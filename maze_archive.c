@@ -0,0 +1,816 @@
+//
+//  maze_archive.c
+//  kruskal-maze-generation-c
+//
+//  Created by Ezzat Chamudi on 10/19/26.
+//  Copyright © 2026 Ezzat Chamudi. All rights reserved.
+//  License: Apache-2.0
+//
+
+#include "maze_archive.h"
+
+#include <pthread.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "maze_walls.h"
+#include "randomized_kruskal.h"
+#include "rng.h"
+
+static void put_u32(unsigned char *bytes, unsigned int value)
+{
+    for (int i = 0; i < 4; i++)
+        bytes[i] = (value >> (8 * i)) & 0xFF;
+}
+
+static void put_u64(unsigned char *bytes, unsigned long long value)
+{
+    for (int i = 0; i < 8; i++)
+        bytes[i] = (value >> (8 * i)) & 0xFF;
+}
+
+static unsigned int get_u32(const unsigned char *bytes)
+{
+    unsigned int value = 0;
+    for (int i = 0; i < 4; i++)
+        value |= (unsigned int)bytes[i] << (8 * i);
+    return value;
+}
+
+static unsigned long long get_u64(const unsigned char *bytes)
+{
+    unsigned long long value = 0;
+    for (int i = 0; i < 8; i++)
+        value |= (unsigned long long)bytes[i] << (8 * i);
+    return value;
+}
+
+// Binary range coder with adaptive probabilities, as in LZMA: 11-bit
+// probabilities of a zero, moved 1/32 of the way towards each coded bit.
+
+#define PROBABILITY_BITS 11
+#define PROBABILITY_ONE (1 << PROBABILITY_BITS)
+#define PROBABILITY_SHIFT 5
+#define RANGE_TOP (1u << 24)
+
+struct range_encoder {
+    unsigned long long low;
+    unsigned int range;
+    unsigned char cache;
+    long long cache_size;
+
+    unsigned char *bytes;
+    size_t total_bytes;
+    size_t capacity;
+};
+
+struct range_decoder {
+    unsigned int code;
+    unsigned int range;
+
+    const unsigned char *bytes;
+    size_t total_bytes;
+    size_t position;
+    bool overrun;
+};
+
+static void put_byte(struct range_encoder *encoder, unsigned char byte)
+{
+    if (encoder->total_bytes == encoder->capacity)
+    {
+        encoder->capacity = encoder->capacity ? encoder->capacity * 2 : 4096;
+        encoder->bytes = (unsigned char *)realloc(encoder->bytes, encoder->capacity);
+    }
+    encoder->bytes[encoder->total_bytes++] = byte;
+}
+
+static void shift_low(struct range_encoder *encoder)
+{
+    // Bytes of 0xFF wait in cache_size until a carry is ruled out
+    if ((unsigned int)encoder->low < 0xFF000000u || (encoder->low >> 32) != 0)
+    {
+        unsigned char carry = (unsigned char)(encoder->low >> 32);
+        unsigned char byte = encoder->cache;
+        do {
+            put_byte(encoder, byte + carry);
+            byte = 0xFF;
+        } while (--encoder->cache_size != 0);
+        encoder->cache = (unsigned char)(encoder->low >> 24);
+    }
+    encoder->cache_size++;
+    encoder->low = (encoder->low & 0x00FFFFFFu) << 8;
+}
+
+static void encode_bit(struct range_encoder *encoder, unsigned short *probability, int bit)
+{
+    unsigned int bound = (encoder->range >> PROBABILITY_BITS) * *probability;
+
+    if (bit == 0) {
+        encoder->range = bound;
+        *probability += (PROBABILITY_ONE - *probability) >> PROBABILITY_SHIFT;
+    } else {
+        encoder->low += bound;
+        encoder->range -= bound;
+        *probability -= *probability >> PROBABILITY_SHIFT;
+    }
+
+    while (encoder->range < RANGE_TOP)
+    {
+        encoder->range <<= 8;
+        shift_low(encoder);
+    }
+}
+
+static unsigned char next_byte(struct range_decoder *decoder)
+{
+    if (decoder->position < decoder->total_bytes)
+        return decoder->bytes[decoder->position++];
+
+    decoder->overrun = true;
+    return 0;
+}
+
+static int decode_bit(struct range_decoder *decoder, unsigned short *probability)
+{
+    unsigned int bound = (decoder->range >> PROBABILITY_BITS) * *probability;
+    int bit;
+
+    if (decoder->code < bound) {
+        decoder->range = bound;
+        *probability += (PROBABILITY_ONE - *probability) >> PROBABILITY_SHIFT;
+        bit = 0;
+    } else {
+        decoder->code -= bound;
+        decoder->range -= bound;
+        *probability -= *probability >> PROBABILITY_SHIFT;
+        bit = 1;
+    }
+
+    while (decoder->range < RANGE_TOP)
+    {
+        decoder->range <<= 8;
+        decoder->code = (decoder->code << 8) | next_byte(decoder);
+    }
+
+    return bit;
+}
+
+// Wall model. Walls are visited cell by cell in storage order; each cell
+// decides its bottom wall, then its right wall. Its top and left walls were
+// decided by earlier cells. A wall's context is five nearby decided walls
+// and the frontier level of the two components it separates.
+
+#define BOTTOM_CONTEXTS 128
+#define RIGHT_CONTEXTS 128
+
+struct wall_model {
+    unsigned short bottom[BOTTOM_CONTEXTS];
+    unsigned short right[RIGHT_CONTEXTS];
+};
+
+struct maze_coder {
+    int size;
+    struct wall_model model;
+
+    // Components of the open passages so far, and how many undecided walls
+    // each has on its boundary. Undecided walls inside a component (they
+    // will be forced closed) still count, so the number is an upper bound.
+    int *parents;
+    int *frontier;
+
+    struct range_encoder *encoder;
+    struct range_decoder *decoder;
+
+    // Set when an encoded maze isn't perfect, so the forced walls were wrong
+    bool mismatch;
+};
+
+static void model_reset(struct wall_model *model)
+{
+    for (int i = 0; i < BOTTOM_CONTEXTS; i++)
+        model->bottom[i] = PROBABILITY_ONE / 2;
+    for (int i = 0; i < RIGHT_CONTEXTS; i++)
+        model->right[i] = PROBABILITY_ONE / 2;
+}
+
+static int find_component(int *parents, int cell)
+{
+    while (parents[cell] != cell)
+    {
+        parents[cell] = parents[parents[cell]];
+        cell = parents[cell];
+    }
+    return cell;
+}
+
+// Decides one wall between cells a and b: forced by the tree structure, or
+// coded with the given probability. Returns whether it is open.
+static bool code_wall(struct maze_coder *coder, int a, int b, unsigned short *probability, bool open)
+{
+    int room_a = find_component(coder->parents, a);
+    int room_b = find_component(coder->parents, b);
+
+    if (room_a == room_b)
+    {
+        // Would close a loop
+        coder->mismatch |= open;
+        coder->frontier[room_a] -= 2;
+        return false;
+    }
+
+    if (coder->frontier[room_a] == 1 || coder->frontier[room_b] == 1)
+    {
+        // Last way out of a component
+        coder->mismatch |= coder->encoder && !open;
+        open = true;
+    }
+    else if (coder->encoder)
+    {
+        encode_bit(coder->encoder, probability, open);
+    }
+    else
+    {
+        open = decode_bit(coder->decoder, probability);
+    }
+
+    if (open)
+    {
+        coder->parents[room_b] = room_a;
+        coder->frontier[room_a] += coder->frontier[room_b] - 2;
+    }
+    else
+    {
+        coder->frontier[room_a]--;
+        coder->frontier[room_b]--;
+    }
+
+    return open;
+}
+
+// How boxed in the smaller side of a wall is: a component with few ways
+// out left is likely to take this one
+static int frontier_level(struct maze_coder *coder, int a, int b)
+{
+    int frontier_a = coder->frontier[find_component(coder->parents, a)];
+    int frontier_b = coder->frontier[find_component(coder->parents, b)];
+    int frontier = frontier_a < frontier_b ? frontier_a : frontier_b;
+
+    return frontier <= 2 ? 0 : frontier == 3 ? 1 : frontier <= 5 ? 2 : 3;
+}
+
+// Encodes cells, or decodes into them, depending on which side the coder has
+static void code_maze(struct maze_coder *coder, unsigned char *cells)
+{
+    const int size = coder->size;
+    const bool decoding = coder->decoder != NULL;
+
+    for (int x = 0; x < size; x++)
+    {
+        for (int y = 0; y < size; y++)
+        {
+            int cell = x * size + y;
+            coder->parents[cell] = cell;
+            coder->frontier[cell] = (x > 0) + (x < size - 1) + (y > 0) + (y < size - 1);
+            if (decoding)
+                cells[cell] = 0;
+        }
+    }
+
+    for (int x = 0; x < size; x++)
+    {
+        for (int y = 0; y < size; y++)
+        {
+            int cell = x * size + y;
+
+            if (y < size - 1)
+            {
+                int below = cell + 1;
+                int context = ((cells[cell] & PASSAGE_TOP) ? 1 : 0)
+                    | ((cells[cell] & PASSAGE_LEFT) ? 2 : 0)
+                    | ((cells[below] & PASSAGE_LEFT) ? 4 : 0)
+                    | (x > 0 && (cells[cell - size] & PASSAGE_BOTTOM) ? 8 : 0)
+                    | (y > 0 && (cells[cell - 1] & PASSAGE_RIGHT) ? 16 : 0)
+                    | (frontier_level(coder, cell, below) << 5);
+
+                bool open = code_wall(coder, cell, below, &coder->model.bottom[context], cells[cell] & PASSAGE_BOTTOM);
+                if (decoding && open)
+                {
+                    cells[cell] |= PASSAGE_BOTTOM;
+                    cells[below] |= PASSAGE_TOP;
+                }
+            }
+
+            if (x < size - 1)
+            {
+                int right = cell + size;
+                int context = ((cells[cell] & PASSAGE_TOP) ? 1 : 0)
+                    | ((cells[cell] & PASSAGE_LEFT) ? 2 : 0)
+                    | ((cells[cell] & PASSAGE_BOTTOM) ? 4 : 0)
+                    | (y > 0 && (cells[cell - 1] & PASSAGE_RIGHT) ? 8 : 0)
+                    | ((y < size - 1 && (cells[cell + 1] & PASSAGE_LEFT)) ? 16 : 0)
+                    | (frontier_level(coder, cell, right) << 5);
+
+                bool open = code_wall(coder, cell, right, &coder->model.right[context], cells[cell] & PASSAGE_RIGHT);
+                if (decoding && open)
+                {
+                    cells[cell] |= PASSAGE_RIGHT;
+                    cells[right] |= PASSAGE_LEFT;
+                }
+            }
+        }
+    }
+}
+
+static void coder_init(struct maze_coder *coder, int size)
+{
+    coder->size = size;
+    model_reset(&coder->model);
+    coder->parents = (int *)malloc((size_t)size * size * sizeof(int));
+    coder->frontier = (int *)malloc((size_t)size * size * sizeof(int));
+    coder->encoder = NULL;
+    coder->decoder = NULL;
+    coder->mismatch = false;
+}
+
+static void coder_release(struct maze_coder *coder)
+{
+    free(coder->parents);
+    free(coder->frontier);
+}
+
+// FNV-1a of a block's cells. Any bits decode to some perfect maze, so
+// corruption only shows in the checksum.
+static unsigned int block_checksum(const unsigned char *cells, size_t total_cells)
+{
+    unsigned int hash = 2166136261u;
+    for (size_t i = 0; i < total_cells; i++)
+        hash = (hash ^ cells[i]) * 16777619u;
+    return hash;
+}
+
+// Block: mazes in it (4 bytes), checksum (4 bytes), then the coded walls
+#define BLOCK_HEADER_BYTES 8
+
+unsigned char *maze_archive_encode_block(int size, const unsigned char *cells, int total_mazes, size_t *total_bytes)
+{
+    struct range_encoder encoder = {0, 0xFFFFFFFFu, 0, 1, NULL, 0, 0};
+    struct maze_coder coder;
+    coder_init(&coder, size);
+    coder.encoder = &encoder;
+
+    const size_t maze_bytes = (size_t)size * size;
+    for (int i = 0; i < BLOCK_HEADER_BYTES; i++)
+        put_byte(&encoder, 0);
+
+    for (int i = 0; i < total_mazes; i++)
+        code_maze(&coder, (unsigned char *)cells + maze_bytes * i);
+
+    for (int i = 0; i < 5; i++)
+        shift_low(&encoder);
+
+    coder_release(&coder);
+
+    if (coder.mismatch)
+    {
+        free(encoder.bytes);
+        return NULL;
+    }
+
+    put_u32(encoder.bytes, (unsigned int)total_mazes);
+    put_u32(encoder.bytes + 4, block_checksum(cells, maze_bytes * total_mazes));
+
+    *total_bytes = encoder.total_bytes;
+    return encoder.bytes;
+}
+
+bool maze_archive_decode_block(int size, const unsigned char *bytes, size_t total_bytes, int total_mazes, unsigned char *cells)
+{
+    if (total_bytes < BLOCK_HEADER_BYTES || total_mazes < 0 || (unsigned int)total_mazes > get_u32(bytes))
+        return false;
+
+    struct range_decoder decoder = {0, 0xFFFFFFFFu, bytes + BLOCK_HEADER_BYTES, total_bytes - BLOCK_HEADER_BYTES, 0, false};
+    for (int i = 0; i < 5; i++)
+        decoder.code = (decoder.code << 8) | next_byte(&decoder);
+
+    struct maze_coder coder;
+    coder_init(&coder, size);
+    coder.decoder = &decoder;
+
+    const size_t maze_bytes = (size_t)size * size;
+    bool valid = true;
+
+    for (int i = 0; i < total_mazes && valid; i++)
+    {
+        unsigned char *maze = cells + maze_bytes * i;
+        code_maze(&coder, maze);
+
+        // No loops were possible, so size^2 - 1 passages make a spanning tree
+        long long passages = 0;
+        for (size_t cell = 0; cell < maze_bytes; cell++)
+            passages += ((maze[cell] & PASSAGE_BOTTOM) != 0) + ((maze[cell] & PASSAGE_RIGHT) != 0);
+
+        valid = !decoder.overrun && passages == (long long)maze_bytes - 1;
+    }
+
+    // A prefix of the block can't be checked against the checksum
+    if (valid && (unsigned int)total_mazes == get_u32(bytes))
+        valid = block_checksum(cells, maze_bytes * total_mazes) == get_u32(bytes + 4);
+
+    coder_release(&coder);
+    return valid;
+}
+
+// File format
+
+#define HEADER_BYTES 32
+
+static bool write_header(FILE *stream, int size, int mazes_per_block, long long total_mazes, unsigned long long index_offset)
+{
+    unsigned char header[HEADER_BYTES];
+    memcpy(header, MAZE_ARCHIVE_MAGIC, 4);
+    put_u32(header + 4, MAZE_ARCHIVE_VERSION);
+    put_u32(header + 8, (unsigned int)size);
+    put_u32(header + 12, (unsigned int)mazes_per_block);
+    put_u64(header + 16, (unsigned long long)total_mazes);
+    put_u64(header + 24, index_offset);
+
+    return fwrite(header, 1, sizeof(header), stream) == sizeof(header);
+}
+
+struct maze_archive_writer *maze_archive_writer_create(FILE *stream, int size, int mazes_per_block)
+{
+    if (size < 2 || mazes_per_block < 1 || !write_header(stream, size, mazes_per_block, 0, 0))
+        return NULL;
+
+    struct maze_archive_writer *writer = (struct maze_archive_writer *)calloc(1, sizeof(struct maze_archive_writer));
+    writer->stream = stream;
+    writer->size = size;
+    writer->mazes_per_block = mazes_per_block;
+    writer->pending = (unsigned char *)malloc((size_t)mazes_per_block * size * size);
+    writer->capacity = 64;
+    writer->offsets = (unsigned long long *)malloc(writer->capacity * sizeof(unsigned long long));
+    writer->offsets[0] = HEADER_BYTES;
+
+    return writer;
+}
+
+bool maze_archive_writer_add_block(struct maze_archive_writer *writer, const unsigned char *bytes, size_t total_bytes, int total_mazes)
+{
+    // Only the last block may be short, or maze n couldn't be found from n
+    if (writer->total_pending > 0 || total_mazes < 1 || total_mazes > writer->mazes_per_block
+        || writer->total_mazes % writer->mazes_per_block != 0)
+        return false;
+
+    if (fwrite(bytes, 1, total_bytes, writer->stream) != total_bytes)
+        return false;
+
+    if (writer->total_blocks + 2 > writer->capacity)
+    {
+        writer->capacity *= 2;
+        writer->offsets = (unsigned long long *)realloc(writer->offsets, writer->capacity * sizeof(unsigned long long));
+    }
+
+    writer->offsets[writer->total_blocks + 1] = writer->offsets[writer->total_blocks] + total_bytes;
+    writer->total_blocks++;
+    writer->total_mazes += total_mazes;
+    return true;
+}
+
+static bool flush_pending(struct maze_archive_writer *writer)
+{
+    size_t total_bytes;
+    unsigned char *bytes = maze_archive_encode_block(writer->size, writer->pending, writer->total_pending, &total_bytes);
+
+    int total_mazes = writer->total_pending;
+    writer->total_pending = 0;
+
+    bool written = bytes != NULL && maze_archive_writer_add_block(writer, bytes, total_bytes, total_mazes);
+    free(bytes);
+    return written;
+}
+
+bool maze_archive_writer_add(struct maze_archive_writer *writer, const unsigned char *cells)
+{
+    const size_t maze_bytes = (size_t)writer->size * writer->size;
+
+    memcpy(writer->pending + maze_bytes * writer->total_pending, cells, maze_bytes);
+    writer->total_pending++;
+
+    if (writer->total_pending < writer->mazes_per_block)
+        return true;
+    return flush_pending(writer);
+}
+
+bool maze_archive_writer_finish(struct maze_archive_writer *writer)
+{
+    bool written = writer->total_pending == 0 || flush_pending(writer);
+
+    unsigned long long index_offset = writer->offsets[writer->total_blocks];
+    for (long long i = 0; written && i <= writer->total_blocks; i++)
+    {
+        unsigned char bytes[8];
+        put_u64(bytes, writer->offsets[i]);
+        written = fwrite(bytes, 1, sizeof(bytes), writer->stream) == sizeof(bytes);
+    }
+
+    written = written
+        && fseek(writer->stream, 0, SEEK_SET) == 0
+        && write_header(writer->stream, writer->size, writer->mazes_per_block, writer->total_mazes, index_offset)
+        && fflush(writer->stream) == 0;
+
+    free(writer->pending);
+    free(writer->offsets);
+    free(writer);
+    return written;
+}
+
+// Reading
+
+struct maze_archive *maze_archive_open(FILE *stream)
+{
+    unsigned char header[HEADER_BYTES];
+
+    if (fseek(stream, 0, SEEK_SET) != 0
+        || fread(header, 1, sizeof(header), stream) != sizeof(header)
+        || memcmp(header, MAZE_ARCHIVE_MAGIC, 4) != 0
+        || get_u32(header + 4) != MAZE_ARCHIVE_VERSION)
+        return NULL;
+
+    int size = (int)get_u32(header + 8);
+    int mazes_per_block = (int)get_u32(header + 12);
+    long long total_mazes = (long long)get_u64(header + 16);
+    unsigned long long index_offset = get_u64(header + 24);
+
+    if (size < 2 || size > MAZE_MAX_SIZE || mazes_per_block < 1 || total_mazes < 0)
+        return NULL;
+
+    // The index of total_blocks + 1 offsets has to fit between index_offset
+    // and the end of the file, which also bounds total_mazes
+    if (fseek(stream, 0, SEEK_END) != 0)
+        return NULL;
+    long file_length = ftell(stream);
+    long long total_blocks = total_mazes / mazes_per_block + (total_mazes % mazes_per_block != 0);
+
+    if (file_length < 0 || index_offset < HEADER_BYTES || index_offset > (unsigned long long)file_length
+        || (unsigned long long)total_blocks >= ((unsigned long long)file_length - index_offset) / 8)
+        return NULL;
+
+    struct maze_archive *archive = (struct maze_archive *)calloc(1, sizeof(struct maze_archive));
+    if (archive == NULL)
+        return NULL;
+
+    archive->stream = stream;
+    archive->size = size;
+    archive->mazes_per_block = mazes_per_block;
+    archive->total_mazes = total_mazes;
+    archive->total_blocks = total_blocks;
+    archive->offsets = (unsigned long long *)malloc((total_blocks + 1) * sizeof(unsigned long long));
+
+    // Blocks lie between the header and the index, in order
+    bool valid = archive->offsets != NULL && fseek(stream, (long)index_offset, SEEK_SET) == 0;
+    for (long long i = 0; valid && i <= total_blocks; i++)
+    {
+        unsigned char bytes[8];
+        valid = fread(bytes, 1, sizeof(bytes), stream) == sizeof(bytes);
+        if (!valid)
+            break;
+
+        unsigned long long offset = get_u64(bytes);
+        valid = offset >= HEADER_BYTES && offset <= index_offset && (i == 0 || offset >= archive->offsets[i - 1]);
+        archive->offsets[i] = offset;
+    }
+
+    if (!valid)
+    {
+        maze_archive_close(archive);
+        return NULL;
+    }
+
+    return archive;
+}
+
+void maze_archive_close(struct maze_archive *archive)
+{
+    if (archive == NULL)
+        return;
+    free(archive->offsets);
+    free(archive);
+}
+
+int maze_archive_block_mazes(const struct maze_archive *archive, long long block)
+{
+    long long first = block * archive->mazes_per_block;
+    long long remaining = archive->total_mazes - first;
+    return remaining < archive->mazes_per_block ? (int)remaining : archive->mazes_per_block;
+}
+
+// Decodes the first total_mazes mazes of a block. pread() leaves the file
+// position alone, so threads can share the stream.
+static bool read_block_prefix(const struct maze_archive *archive, long long block, int total_mazes, unsigned char *cells)
+{
+    if (block < 0 || block >= archive->total_blocks)
+        return false;
+
+    // maze_archive_open() keeps the offsets inside the file
+    size_t total_bytes = archive->offsets[block + 1] - archive->offsets[block];
+    unsigned char *bytes = (unsigned char *)malloc(total_bytes + 1);
+
+    bool valid = bytes != NULL && total_bytes >= BLOCK_HEADER_BYTES
+        && pread(fileno(archive->stream), bytes, total_bytes, (off_t)archive->offsets[block]) == (ssize_t)total_bytes
+        && get_u32(bytes) == (unsigned int)maze_archive_block_mazes(archive, block)
+        && maze_archive_decode_block(archive->size, bytes, total_bytes, total_mazes, cells);
+
+    free(bytes);
+    return valid;
+}
+
+bool maze_archive_read_block(const struct maze_archive *archive, long long block, unsigned char *cells)
+{
+    return read_block_prefix(archive, block, maze_archive_block_mazes(archive, block), cells);
+}
+
+bool maze_archive_read(const struct maze_archive *archive, long long maze_number, unsigned char *cells)
+{
+    if (maze_number < 0 || maze_number >= archive->total_mazes)
+        return false;
+
+    // Mazes in a block share the adaptive model, so the ones before it are
+    // decoded too
+    const size_t maze_bytes = (size_t)archive->size * archive->size;
+    int position = (int)(maze_number % archive->mazes_per_block);
+    unsigned char *block_cells = (unsigned char *)malloc(maze_bytes * (position + 1));
+
+    bool valid = block_cells != NULL && read_block_prefix(archive, maze_number / archive->mazes_per_block, position + 1, block_cells);
+    if (valid)
+        memcpy(cells, block_cells + maze_bytes * position, maze_bytes);
+
+    free(block_cells);
+    return valid;
+}
+
+struct archive_job {
+    const struct maze_archive *archive;
+    unsigned char *cells;
+    int thread;
+    int total_threads;
+    bool valid;
+    bool threaded;
+};
+
+static void *read_all_thread(void *argument)
+{
+    struct archive_job *job = (struct archive_job *)argument;
+    const struct maze_archive *archive = job->archive;
+    const size_t block_bytes = (size_t)archive->mazes_per_block * archive->size * archive->size;
+
+    job->valid = true;
+    for (long long block = job->thread; block < archive->total_blocks && job->valid; block += job->total_threads)
+        job->valid = maze_archive_read_block(archive, block, job->cells + block_bytes * block);
+
+    return NULL;
+}
+
+bool maze_archive_read_all(const struct maze_archive *archive, unsigned char *cells, int total_threads)
+{
+    if (total_threads < 1)
+        total_threads = 1;
+
+    struct archive_job *jobs = (struct archive_job *)calloc(total_threads, sizeof(struct archive_job));
+    pthread_t *threads = (pthread_t *)calloc(total_threads, sizeof(pthread_t));
+
+    for (int t = 0; t < total_threads; t++)
+    {
+        jobs[t].archive = archive;
+        jobs[t].cells = cells;
+        jobs[t].thread = t;
+        jobs[t].total_threads = total_threads;
+
+        jobs[t].threaded = t > 0 && pthread_create(&threads[t], NULL, read_all_thread, &jobs[t]) == 0;
+    }
+
+    // Blocks of a thread that couldn't be started are read here
+    for (int t = 0; t < total_threads; t++)
+    {
+        if (!jobs[t].threaded)
+            read_all_thread(&jobs[t]);
+    }
+
+    bool valid = true;
+    for (int t = 0; t < total_threads; t++)
+    {
+        if (jobs[t].threaded)
+            pthread_join(threads[t], NULL);
+        valid = valid && jobs[t].valid;
+    }
+
+    free(jobs);
+    free(threads);
+    return valid;
+}
+
+// Generation
+
+struct generate_job {
+    int size;
+    unsigned int direction_options;
+    unsigned long long seed;
+    long long first_maze;
+    int total_mazes;
+
+    unsigned char *cells;
+    unsigned char *bytes;
+    size_t total_bytes;
+
+    bool threaded;
+};
+
+static void *generate_block_thread(void *argument)
+{
+    struct generate_job *job = (struct generate_job *)argument;
+    const size_t maze_bytes = (size_t)job->size * job->size;
+
+    struct maze_walls *walls = maze_walls_create(job->size);
+
+    for (int i = 0; i < job->total_mazes; i++)
+    {
+        struct rng rng;
+        rng_seed(&rng, rng_derive(job->seed, job->first_maze + i));
+
+        memset(walls->cells, 0, maze_bytes);
+        randomized_kruskal_walls(false, walls, job->direction_options, &rng, NULL);
+        memcpy(job->cells + maze_bytes * i, walls->cells, maze_bytes);
+    }
+
+    maze_walls_free(walls);
+
+    job->bytes = maze_archive_encode_block(job->size, job->cells, job->total_mazes, &job->total_bytes);
+    return NULL;
+}
+
+bool maze_archive_generate(FILE *stream, int size, unsigned int direction_options, unsigned long long seed,
+                           long long total_mazes, int mazes_per_block, int total_threads)
+{
+    struct maze_archive_writer *writer = maze_archive_writer_create(stream, size, mazes_per_block);
+    if (writer == NULL)
+        return false;
+
+    if (total_threads < 1)
+        total_threads = 1;
+
+    struct generate_job *jobs = (struct generate_job *)calloc(total_threads, sizeof(struct generate_job));
+    pthread_t *threads = (pthread_t *)calloc(total_threads, sizeof(pthread_t));
+
+    for (int t = 0; t < total_threads; t++)
+        jobs[t].cells = (unsigned char *)malloc((size_t)mazes_per_block * size * size);
+
+    bool written = true;
+
+    // Each round, thread t makes the next block t; blocks are written in order
+    for (long long first_maze = 0; first_maze < total_mazes && written; )
+    {
+        int round_threads = 0;
+
+        for (int t = 0; t < total_threads && first_maze < total_mazes; t++)
+        {
+            long long remaining = total_mazes - first_maze;
+
+            jobs[t].size = size;
+            jobs[t].direction_options = direction_options;
+            jobs[t].seed = seed;
+            jobs[t].first_maze = first_maze;
+            jobs[t].total_mazes = remaining < mazes_per_block ? (int)remaining : mazes_per_block;
+
+            jobs[t].threaded = t > 0 && pthread_create(&threads[t], NULL, generate_block_thread, &jobs[t]) == 0;
+
+            first_maze += jobs[t].total_mazes;
+            round_threads++;
+        }
+
+        // Blocks of a thread that couldn't be started are made here
+        for (int t = 0; t < round_threads; t++)
+        {
+            if (!jobs[t].threaded)
+                generate_block_thread(&jobs[t]);
+        }
+
+        for (int t = 1; t < round_threads; t++)
+        {
+            if (jobs[t].threaded)
+                pthread_join(threads[t], NULL);
+        }
+
+        for (int t = 0; t < round_threads; t++)
+        {
+            written = written && jobs[t].bytes != NULL
+                && maze_archive_writer_add_block(writer, jobs[t].bytes, jobs[t].total_bytes, jobs[t].total_mazes);
+            free(jobs[t].bytes);
+        }
+    }
+
+    for (int t = 0; t < total_threads; t++)
+        free(jobs[t].cells);
+    free(jobs);
+    free(threads);
+
+    return maze_archive_writer_finish(writer) && written;
+}
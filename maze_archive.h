@@ -0,0 +1,87 @@
+//
+//  maze_archive.h
+//  kruskal-maze-generation-c
+//
+//  Created by Ezzat Chamudi on 10/19/26.
+//  Copyright © 2026 Ezzat Chamudi. All rights reserved.
+//  License: Apache-2.0
+//
+
+#ifndef maze_archive_h
+#define maze_archive_h
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include "definitions.h"
+
+#define MAZE_ARCHIVE_MAGIC "KMAR"
+#define MAZE_ARCHIVE_VERSION 1
+
+// Mazes per block when none is given. Blocks are the unit of random access
+// and of parallel decoding; bigger blocks let the model adapt longer.
+#define MAZE_ARCHIVE_BLOCK_MAZES 1024
+
+// Compressed archive of same-size perfect mazes. Mazes are passed in and out
+// as size * size bytes of passage flags, cell x * size + y (the linear
+// layout, as in a Python MazeBatch).
+//
+// File: a 32-byte header (magic, version, size, mazes per block, total
+// mazes, index offset), then the blocks, then the index: one offset per
+// block plus the end of the last block. Each block is its maze count, a
+// checksum of its cells and its own range-coded stream, so any block
+// decodes without the others.
+//
+// A perfect maze is a spanning tree, so most of its walls are implied: a
+// wall between cells already joined by open passages must be closed, and
+// the last undecided wall of a cell with no passage must be open. Only the
+// other walls are coded, each with an adaptive probability chosen by the
+// nearby walls already known.
+struct maze_archive_writer {
+    FILE *stream;
+    int size;
+    int mazes_per_block;
+    long long total_mazes;
+
+    unsigned char *pending;
+    int total_pending;
+
+    unsigned long long *offsets;
+    long long total_blocks;
+    long long capacity;
+};
+
+struct maze_archive {
+    FILE *stream;
+    int size;
+    int mazes_per_block;
+    long long total_mazes;
+    long long total_blocks;
+    unsigned long long *offsets;
+};
+
+// Block coding. encode returns a malloc'd buffer, or NULL if a maze isn't
+// perfect; decode returns false on a truncated or corrupt block.
+extern unsigned char *maze_archive_encode_block(int size, const unsigned char *cells, int total_mazes, size_t *total_bytes);
+extern bool maze_archive_decode_block(int size, const unsigned char *bytes, size_t total_bytes, int total_mazes, unsigned char *cells);
+
+// Writing needs a seekable stream: the header is completed on finish
+extern struct maze_archive_writer *maze_archive_writer_create(FILE *stream, int size, int mazes_per_block);
+extern bool maze_archive_writer_add(struct maze_archive_writer *writer, const unsigned char *cells);
+extern bool maze_archive_writer_add_block(struct maze_archive_writer *writer, const unsigned char *bytes, size_t total_bytes, int total_mazes);
+extern bool maze_archive_writer_finish(struct maze_archive_writer *writer);
+
+extern struct maze_archive *maze_archive_open(FILE *stream);
+extern void maze_archive_close(struct maze_archive *archive);
+extern int maze_archive_block_mazes(const struct maze_archive *archive, long long block);
+extern bool maze_archive_read_block(const struct maze_archive *archive, long long block, unsigned char *cells);
+extern bool maze_archive_read(const struct maze_archive *archive, long long maze_number, unsigned char *cells);
+extern bool maze_archive_read_all(const struct maze_archive *archive, unsigned char *cells, int total_threads);
+
+// Generates maze i from rng_derive(seed, i), as generate_batch() does, and
+// encodes whole blocks on total_threads threads
+extern bool maze_archive_generate(FILE *stream, int size, unsigned int direction_options, unsigned long long seed,
+                                  long long total_mazes, int mazes_per_block, int total_threads);
+
+#endif /* maze_archive_h */
@@ -0,0 +1,78 @@
+//
+//  maze_engine.c
+//  kruskal-maze-generation-c
+//
+//  Created by Ezzat Chamudi on 10/19/26.
+//  Copyright © 2026 Ezzat Chamudi. All rights reserved.
+//  License: Apache-2.0
+//
+
+#include "maze_engine.h"
+
+#include "eller.h"
+#include "randomized_kruskal.h"
+#include "recursive_backtracker.h"
+#include "union_find_kruskal.h"
+#include "wilson.h"
+
+static void kruskal_engine(struct maze_walls *walls, unsigned int direction_options, struct rng *rng)
+{
+    randomized_kruskal_walls(false, walls, direction_options, rng, NULL);
+}
+
+static void union_find_engine(struct maze_walls *walls, unsigned int direction_options, struct rng *rng)
+{
+    (void)direction_options;
+    union_find_kruskal_walls(walls, rng);
+}
+
+static void backtracker_engine(struct maze_walls *walls, unsigned int direction_options, struct rng *rng)
+{
+    (void)direction_options;
+    recursive_backtracker_walls(walls, rng);
+}
+
+static void eller_engine(struct maze_walls *walls, unsigned int direction_options, struct rng *rng)
+{
+    (void)direction_options;
+    eller_walls(walls, rng);
+}
+
+static void wilson_engine(struct maze_walls *walls, unsigned int direction_options, struct rng *rng)
+{
+    (void)direction_options;
+    wilson_walls(walls, rng);
+}
+
+const struct maze_engine maze_engines[] = {
+    {"kruskal", "O(n) expected passes plus failed retries, random access",
+     ENABLE_STANDARD | ENABLE_DIAGONAL | ENABLE_LETTERS | UNIFORM_SAMPLING | LETTER_PREPASS, kruskal_engine},
+    {"union-find", "O(E a(n)) over a lazily shuffled edge list, 8 bytes per cell",
+     ENABLE_STANDARD, union_find_engine},
+    {"backtracker", "O(n), stack up to n cells, long corridors",
+     ENABLE_STANDARD, backtracker_engine},
+    {"eller", "O(n a(size)) row by row, O(size) working memory",
+     ENABLE_STANDARD, eller_engine},
+    {"wilson", "O(n log n) expected walk steps, uniform spanning tree",
+     ENABLE_STANDARD, wilson_engine},
+};
+
+const int total_maze_engines = sizeof(maze_engines) / sizeof(maze_engines[0]);
+
+const struct maze_engine *maze_engine_find(const char *name)
+{
+    for (int i = 0; i < total_maze_engines; i++)
+    {
+        if (strcmp(maze_engines[i].name, name) == 0)
+            return &maze_engines[i];
+    }
+    return NULL;
+}
+
+void maze_engine_generate(const struct maze_engine *engine, struct maze_walls *walls, unsigned int direction_options, unsigned long long seed)
+{
+    struct rng rng;
+    rng_seed(&rng, seed);
+
+    engine->generate(walls, direction_options & engine->direction_options, &rng);
+}
@@ -0,0 +1,37 @@
+//
+//  maze_engine.h
+//  kruskal-maze-generation-c
+//
+//  Created by Ezzat Chamudi on 10/19/26.
+//  Copyright © 2026 Ezzat Chamudi. All rights reserved.
+//  License: Apache-2.0
+//
+
+#ifndef maze_engine_h
+#define maze_engine_h
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "definitions.h"
+#include "maze_walls.h"
+#include "rng.h"
+
+// A perfect-maze generator writing into a cleared maze_walls. Only the
+// modified Kruskal engine knows diagonal and letter moves; the others build
+// standard-direction mazes whatever the options say.
+struct maze_engine {
+    const char *name;
+    const char *cost;
+    unsigned int direction_options; // Options the engine honours
+    void (*generate)(struct maze_walls *walls, unsigned int direction_options, struct rng *rng);
+};
+
+extern const struct maze_engine maze_engines[];
+extern const int total_maze_engines;
+
+extern const struct maze_engine *maze_engine_find(const char *name);
+extern void maze_engine_generate(const struct maze_engine *engine, struct maze_walls *walls, unsigned int direction_options, unsigned long long seed);
+
+#endif /* maze_engine_h */
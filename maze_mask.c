@@ -0,0 +1,123 @@
+//
+//  maze_mask.c
+//  kruskal-maze-generation-c
+//
+//  Created by Ezzat Chamudi on 10/19/26.
+//  Copyright © 2026 Ezzat Chamudi. All rights reserved.
+//  License: Apache-2.0
+//
+
+#include "maze_mask.h"
+
+#include <limits.h>
+#include <string.h>
+
+struct maze_mask *maze_mask_create(int width, int height)
+{
+    struct maze_mask *mask = (struct maze_mask *)calloc(1, sizeof(struct maze_mask));
+    mask->width = width;
+    mask->height = height;
+    mask->live = (unsigned char *)malloc((size_t)width * height);
+    memset(mask->live, 1, (size_t)width * height);
+    mask->total_live = width * height;
+    return mask;
+}
+
+void maze_mask_free(struct maze_mask *mask)
+{
+    if (mask == NULL)
+        return;
+    free(mask->live);
+    free(mask);
+}
+
+void maze_mask_set(struct maze_mask *mask, int x, int y, bool live)
+{
+    unsigned char *cell = &mask->live[y * mask->width + x];
+    mask->total_live += (int)live - (int)*cell;
+    *cell = live;
+}
+
+struct maze_mask *maze_mask_read(FILE *stream)
+{
+    char **lines = NULL;
+    int total_lines = 0;
+    int width = 0;
+    char buffer[65536];
+
+    while (fgets(buffer, sizeof(buffer), stream) != NULL)
+    {
+        size_t length = strcspn(buffer, "\r\n");
+        buffer[length] = '\0';
+
+        lines = (char **)realloc(lines, (total_lines + 1) * sizeof(char *));
+        lines[total_lines++] = strdup(buffer);
+        if ((int)length > width)
+            width = (int)length;
+    }
+
+    // Trailing blank lines are not rows
+    while (total_lines > 0 && lines[total_lines - 1][0] == '\0')
+        free(lines[--total_lines]);
+
+    struct maze_mask *mask = NULL;
+    // Cell indices are ints
+    if (width > 0 && total_lines > 0 && (long long)width * total_lines <= INT_MAX)
+    {
+        mask = maze_mask_create(width, total_lines);
+        for (int y = 0; y < total_lines; y++)
+        {
+            int length = (int)strlen(lines[y]);
+            for (int x = 0; x < width; x++)
+                maze_mask_set(mask, x, y, x < length && lines[y][x] != '#');
+        }
+    }
+
+    for (int y = 0; y < total_lines; y++)
+        free(lines[y]);
+    free(lines);
+
+    return mask;
+}
+
+bool maze_mask_connected(const struct maze_mask *mask)
+{
+    const int total_cells = mask->width * mask->height;
+    int *queue = (int *)malloc((total_cells + 1) * sizeof(int));
+    unsigned char *seen = (unsigned char *)calloc(total_cells + 1, sizeof(unsigned char));
+    int head = 0;
+    int tail = 0;
+
+    for (int i = 0; i < total_cells && tail == 0; i++)
+    {
+        if (mask->live[i])
+        {
+            queue[tail++] = i;
+            seen[i] = 1;
+        }
+    }
+
+    while (head < tail)
+    {
+        int cell = queue[head++];
+        int x = cell % mask->width;
+        int y = cell / mask->width;
+        const int dx[4] = {0, 1, 0, -1};
+        const int dy[4] = {-1, 0, 1, 0};
+
+        for (int i = 0; i < 4; i++)
+        {
+            int next = (y + dy[i]) * mask->width + x + dx[i];
+            if (maze_mask_live(mask, x + dx[i], y + dy[i]) && !seen[next])
+            {
+                seen[next] = 1;
+                queue[tail++] = next;
+            }
+        }
+    }
+
+    free(queue);
+    free(seen);
+
+    return tail == mask->total_live;
+}
@@ -0,0 +1,47 @@
+//
+//  maze_mask.h
+//  kruskal-maze-generation-c
+//
+//  Created by Ezzat Chamudi on 10/19/26.
+//  Copyright © 2026 Ezzat Chamudi. All rights reserved.
+//  License: Apache-2.0
+//
+
+#ifndef maze_mask_h
+#define maze_mask_h
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include "definitions.h"
+
+// Which cells of a width x height grid belong to the maze. Masked cells,
+// like everything past the edge, are never linked.
+struct maze_mask {
+    int width;
+    int height;
+    unsigned char *live; // live[y * width + x]
+    int total_live;
+};
+
+// All cells live
+extern struct maze_mask *maze_mask_create(int width, int height);
+extern void maze_mask_free(struct maze_mask *mask);
+extern void maze_mask_set(struct maze_mask *mask, int x, int y, bool live);
+
+// One text line per row, '#' for a masked cell and anything else for a live
+// one. The grid is as wide as the longest line; short lines are padded with
+// masked cells. NULL if there are no rows or more than INT_MAX cells.
+extern struct maze_mask *maze_mask_read(FILE *stream);
+
+// Whether every live cell reaches every other through live neighbours, so a
+// spanning tree exists
+extern bool maze_mask_connected(const struct maze_mask *mask);
+
+static inline bool maze_mask_live(const struct maze_mask *mask, int x, int y)
+{
+    return x >= 0 && y >= 0 && x < mask->width && y < mask->height && mask->live[y * mask->width + x];
+}
+
+#endif /* maze_mask_h */
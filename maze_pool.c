@@ -0,0 +1,181 @@
+//
+//  maze_pool.c
+//  kruskal-maze-generation-c
+//
+//  Created by Ezzat Chamudi on 10/19/26.
+//  Copyright © 2026 Ezzat Chamudi. All rights reserved.
+//  License: Apache-2.0
+//
+
+#include "maze_pool.h"
+
+#include <time.h>
+#include <unistd.h>
+
+#include "randomized_kruskal.h"
+#include "rng.h"
+
+struct worker_args {
+    struct maze_pool_set *set;
+    int index;
+};
+
+static struct maze_pool *find_pool(struct maze_pool_set *set, int size, unsigned int direction_options)
+{
+    for (int i = 0; i < set->total_pools; i++)
+    {
+        struct maze_pool *pool = &set->pools[i];
+        if (pool->config.size == size && pool->config.direction_options == direction_options)
+            return pool;
+    }
+    return NULL;
+}
+
+// Pool with the lowest fill ratio, or NULL when every pool is full
+static struct maze_pool *emptiest_pool(struct maze_pool_set *set)
+{
+    struct maze_pool *emptiest = NULL;
+    double lowest_fill = 1.0;
+
+    for (int i = 0; i < set->total_pools; i++)
+    {
+        struct maze_pool *pool = &set->pools[i];
+        double fill = (double)(pool->total_mazes + pool->total_generating) / pool->config.capacity;
+        if (fill < lowest_fill)
+        {
+            lowest_fill = fill;
+            emptiest = pool;
+        }
+    }
+    return emptiest;
+}
+
+static void *refill_worker(void *data)
+{
+    struct worker_args *args = (struct worker_args *)data;
+    struct maze_pool_set *set = args->set;
+
+    struct rng rng;
+    rng_seed(&rng, (unsigned long long)time(NULL) ^ ((unsigned long long)getpid() << 32) ^ ((unsigned long long)args->index * 0x9E3779B97F4A7C15ULL));
+    free(args);
+
+    pthread_mutex_lock(&set->lock);
+
+    while (!set->stopping)
+    {
+        struct maze_pool *pool = emptiest_pool(set);
+
+        if (pool == NULL)
+        {
+            pthread_cond_wait(&set->refill, &set->lock);
+            continue;
+        }
+
+        // Count the maze in while generating so other workers move on
+        struct maze_pool_config config = pool->config;
+        pool->total_generating++;
+        pthread_mutex_unlock(&set->lock);
+
+        struct maze_walls *walls = maze_walls_create(config.size);
+        randomized_kruskal_walls(false, walls, config.direction_options, &rng, NULL);
+
+        pthread_mutex_lock(&set->lock);
+        pool->total_generating--;
+        pool->mazes[pool->total_mazes] = walls;
+        pool->total_mazes++;
+    }
+
+    pthread_mutex_unlock(&set->lock);
+    return NULL;
+}
+
+struct maze_pool_set *maze_pool_set_create(const struct maze_pool_config *configs, int total_pools, int total_workers)
+{
+    struct maze_pool_set *set = (struct maze_pool_set *)calloc(1, sizeof(struct maze_pool_set));
+
+    set->total_pools = total_pools;
+    set->pools = (struct maze_pool *)calloc(total_pools, sizeof(struct maze_pool));
+    for (int i = 0; i < total_pools; i++)
+    {
+        set->pools[i].config = configs[i];
+        set->pools[i].mazes = (struct maze_walls **)calloc(configs[i].capacity, sizeof(struct maze_walls *));
+    }
+
+    pthread_mutex_init(&set->lock, NULL);
+    pthread_cond_init(&set->refill, NULL);
+
+    set->total_workers = total_workers;
+    set->workers = (pthread_t *)calloc(total_workers, sizeof(pthread_t));
+    for (int i = 0; i < total_workers; i++)
+    {
+        struct worker_args *args = (struct worker_args *)calloc(1, sizeof(struct worker_args));
+        args->set = set;
+        args->index = i;
+        if (pthread_create(&set->workers[i], NULL, refill_worker, args) != 0)
+        {
+            // Stop the workers already running
+            free(args);
+            set->total_workers = i;
+            maze_pool_set_free(set);
+            return NULL;
+        }
+    }
+
+    return set;
+}
+
+void maze_pool_set_free(struct maze_pool_set *set)
+{
+    pthread_mutex_lock(&set->lock);
+    set->stopping = true;
+    pthread_cond_broadcast(&set->refill);
+    pthread_mutex_unlock(&set->lock);
+
+    for (int i = 0; i < set->total_workers; i++)
+        pthread_join(set->workers[i], NULL);
+
+    for (int i = 0; i < set->total_pools; i++)
+    {
+        for (int j = 0; j < set->pools[i].total_mazes; j++)
+            maze_walls_free(set->pools[i].mazes[j]);
+        free(set->pools[i].mazes);
+    }
+
+    pthread_mutex_destroy(&set->lock);
+    pthread_cond_destroy(&set->refill);
+
+    free(set->pools);
+    free(set->workers);
+    free(set);
+}
+
+bool maze_pool_has(struct maze_pool_set *set, int size, unsigned int direction_options)
+{
+    return find_pool(set, size, direction_options) != NULL;
+}
+
+struct maze_walls *maze_pool_take(struct maze_pool_set *set, int size, unsigned int direction_options)
+{
+    struct maze_walls *walls = NULL;
+
+    pthread_mutex_lock(&set->lock);
+
+    struct maze_pool *pool = find_pool(set, size, direction_options);
+
+    if (pool && pool->total_mazes > 0)
+    {
+        pool->total_mazes--;
+        walls = pool->mazes[pool->total_mazes];
+        pool->mazes[pool->total_mazes] = NULL;
+        pool->hits++;
+        pthread_cond_signal(&set->refill);
+    }
+    else if (pool)
+    {
+        pool->misses++;
+    }
+
+    pthread_mutex_unlock(&set->lock);
+
+    return walls;
+}
@@ -0,0 +1,53 @@
+//
+//  maze_pool.h
+//  kruskal-maze-generation-c
+//
+//  Created by Ezzat Chamudi on 10/19/26.
+//  Copyright © 2026 Ezzat Chamudi. All rights reserved.
+//  License: Apache-2.0
+//
+
+#ifndef maze_pool_h
+#define maze_pool_h
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <pthread.h>
+
+#include "definitions.h"
+#include "maze_walls.h"
+
+struct maze_pool_config {
+    int size;
+    unsigned int direction_options;
+    int capacity;
+};
+
+// Pre-generated mazes of one hot configuration
+struct maze_pool {
+    struct maze_pool_config config;
+    struct maze_walls **mazes;
+    int total_mazes;
+    int total_generating;
+    long hits;
+    long misses;
+};
+
+// All pools share one lock; background workers keep them topped up.
+struct maze_pool_set {
+    struct maze_pool *pools;
+    int total_pools;
+    pthread_mutex_t lock;
+    pthread_cond_t refill;
+    bool stopping;
+    pthread_t *workers;
+    int total_workers;
+};
+
+// NULL when the workers can't be started
+extern struct maze_pool_set *maze_pool_set_create(const struct maze_pool_config *configs, int total_pools, int total_workers);
+extern void maze_pool_set_free(struct maze_pool_set *set);
+extern bool maze_pool_has(struct maze_pool_set *set, int size, unsigned int direction_options);
+extern struct maze_walls *maze_pool_take(struct maze_pool_set *set, int size, unsigned int direction_options);
+
+#endif /* maze_pool_h */
@@ -0,0 +1,111 @@
+//
+//  maze_tiles.c
+//  kruskal-maze-generation-c
+//
+//  Created by Ezzat Chamudi on 10/19/26.
+//  Copyright © 2026 Ezzat Chamudi. All rights reserved.
+//  License: Apache-2.0
+//
+
+#include "maze_tiles.h"
+
+// Open share of a cell's right and bottom walls. Walls on the maze edge
+// count as closed, like the border around it.
+static unsigned char cell_openness(const struct maze_walls *walls, int x, int y)
+{
+    unsigned char passages = walls->cells[maze_cell_index(walls, x, y)];
+    return ((passages & PASSAGE_RIGHT) ? 128 : 0) + ((passages & PASSAGE_BOTTOM) ? 127 : 0);
+}
+
+struct maze_tiles *maze_tiles_create(const struct maze_walls *walls)
+{
+    struct maze_tiles *tiles = (struct maze_tiles *)calloc(1, sizeof(struct maze_tiles));
+    tiles->walls = walls;
+
+    // Halve until one byte covers the maze
+    tiles->total_levels = 1;
+    for (int side = walls->size; side > 1; side = (side + 1) / 2)
+        tiles->total_levels++;
+
+    tiles->level_sizes = (int *)calloc(tiles->total_levels, sizeof(int));
+    tiles->levels = (unsigned char **)calloc(tiles->total_levels, sizeof(unsigned char *));
+    tiles->level_sizes[0] = walls->size;
+
+    for (int level = 1; level < tiles->total_levels; level++)
+    {
+        const int below_size = tiles->level_sizes[level - 1];
+        const int size = (below_size + 1) / 2;
+        unsigned char *bytes = (unsigned char *)malloc((size_t)size * size);
+
+        tiles->level_sizes[level] = size;
+        tiles->levels[level] = bytes;
+
+        for (int x = 0; x < size; x++)
+        {
+            for (int y = 0; y < size; y++)
+            {
+                // Average of the (up to) four cells below, edges included
+                int sum = 0, count = 0;
+                for (int dx = 0; dx < 2; dx++)
+                {
+                    for (int dy = 0; dy < 2; dy++)
+                    {
+                        int below_x = 2 * x + dx;
+                        int below_y = 2 * y + dy;
+                        if (below_x >= below_size || below_y >= below_size)
+                            continue;
+
+                        sum += level == 1
+                            ? cell_openness(walls, below_x, below_y)
+                            : tiles->levels[level - 1][(size_t)below_x * below_size + below_y];
+                        count++;
+                    }
+                }
+
+                bytes[(size_t)x * size + y] = (unsigned char)((sum + count / 2) / count);
+            }
+        }
+    }
+
+    return tiles;
+}
+
+void maze_tiles_free(struct maze_tiles *tiles)
+{
+    if (tiles == NULL)
+        return;
+
+    for (int level = 1; level < tiles->total_levels; level++)
+        free(tiles->levels[level]);
+    free(tiles->levels);
+    free(tiles->level_sizes);
+    free(tiles);
+}
+
+void maze_tiles_query(const struct maze_tiles *tiles, int level, int x0, int y0, int columns, int rows, unsigned char *tile)
+{
+    if (level < 0)
+        level = 0;
+    if (level >= tiles->total_levels)
+        level = tiles->total_levels - 1;
+
+    const int size = tiles->level_sizes[level];
+
+    for (int row = 0; row < rows; row++)
+    {
+        int y = y0 + row;
+        unsigned char *out = tile + (size_t)row * columns;
+
+        for (int column = 0; column < columns; column++)
+        {
+            int x = x0 + column;
+
+            if (x < 0 || y < 0 || x >= size || y >= size)
+                out[column] = level == 0 ? MAZE_TILE_OUTSIDE : 0;
+            else if (level == 0)
+                out[column] = tiles->walls->cells[maze_cell_index(tiles->walls, x, y)];
+            else
+                out[column] = tiles->levels[level][(size_t)x * size + y];
+        }
+    }
+}
@@ -0,0 +1,41 @@
+//
+//  maze_tiles.h
+//  kruskal-maze-generation-c
+//
+//  Created by Ezzat Chamudi on 10/19/26.
+//  Copyright © 2026 Ezzat Chamudi. All rights reserved.
+//  License: Apache-2.0
+//
+
+#ifndef maze_tiles_h
+#define maze_tiles_h
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "definitions.h"
+#include "maze_walls.h"
+
+// Level 0 tiles hold passage flags; this marks cells past the maze edge
+#define MAZE_TILE_OUTSIDE 0x80
+
+// Region queries for drawing a window of a big maze. Level 0 is the maze
+// itself. Level k averages 2^k x 2^k cells into one byte, the share of
+// their right and bottom walls that are open (0..255), so a zoomed-out view
+// reads one byte per pixel instead of every cell under it. The levels are
+// built once, about a third of the maze in bytes.
+struct maze_tiles {
+    const struct maze_walls *walls;
+    int total_levels;
+    int *level_sizes;
+    unsigned char **levels; // levels[0] is unused, level 0 reads the walls
+};
+
+extern struct maze_tiles *maze_tiles_create(const struct maze_walls *walls);
+extern void maze_tiles_free(struct maze_tiles *tiles);
+
+// Fills tile[row * columns + column] with cell (x0 + column, y0 + row) of
+// the level, x0 and y0 in that level's cells
+extern void maze_tiles_query(const struct maze_tiles *tiles, int level, int x0, int y0, int columns, int rows, unsigned char *tile);
+
+#endif /* maze_tiles_h */
@@ -0,0 +1,172 @@
+//
+//  maze_walls.c
+//  kruskal-maze-generation-c
+//
+//  Created by Ezzat Chamudi on 10/19/26.
+//  Copyright © 2026 Ezzat Chamudi. All rights reserved.
+//  License: Apache-2.0
+//
+
+#include "maze_walls.h"
+
+#include <limits.h>
+#include <string.h>
+
+struct maze_walls *maze_walls_create(int size)
+{
+    return maze_walls_create_with(size, MAZE_LAYOUT_LINEAR, &default_allocator);
+}
+
+static struct maze_walls *create_walls(int width, int height, int layout, const struct maze_allocator *allocator)
+{
+    struct maze_walls *walls = (struct maze_walls *)calloc(1, sizeof(struct maze_walls));
+    walls->size = width == height ? width : 0;
+    walls->width = width;
+    walls->height = height;
+    walls->layout = layout;
+    walls->allocator = allocator;
+
+    if (layout == MAZE_LAYOUT_MORTON)
+    {
+        int side = 1;
+        while (side < width)
+            side *= 2;
+        walls->total_cells = side * side;
+    }
+    else
+    {
+        walls->total_cells = width * height;
+    }
+
+    walls->cells = (unsigned char *)maze_allocate(allocator, (size_t)walls->total_cells * sizeof(unsigned char));
+
+    if (walls->cells == NULL)
+    {
+        printf("ERROR: Can't allocate a %d x %d maze.\n", width, height);
+        exit(1);
+    }
+
+    return walls;
+}
+
+struct maze_walls *maze_walls_create_with(int size, int layout, const struct maze_allocator *allocator)
+{
+    if (size < 1 || size > (layout == MAZE_LAYOUT_MORTON ? MAZE_MAX_MORTON_SIZE : MAZE_MAX_SIZE))
+    {
+        printf("ERROR: Can't store a maze of size %d in the %s layout.\n", size,
+               layout == MAZE_LAYOUT_MORTON ? "Morton" : "linear");
+        exit(1);
+    }
+
+    return create_walls(size, size, layout, allocator);
+}
+
+struct maze_walls *maze_walls_create_rect(int width, int height)
+{
+    if (width < 1 || height < 1 || (long long)width * height > INT_MAX)
+    {
+        printf("ERROR: Can't store a %d x %d maze.\n", width, height);
+        exit(1);
+    }
+
+    return create_walls(width, height, MAZE_LAYOUT_LINEAR, &default_allocator);
+}
+
+void maze_walls_free(struct maze_walls *walls)
+{
+    if (walls == NULL)
+        return;
+    maze_release(walls->allocator, walls->cells, (size_t)walls->total_cells * sizeof(unsigned char));
+    free(walls);
+}
+
+struct maze_walls *maze_walls_copy(const struct maze_walls *walls)
+{
+    struct maze_walls *copy = create_walls(walls->width, walls->height, walls->layout, walls->allocator);
+    memcpy(copy->cells, walls->cells, (size_t)walls->total_cells);
+    return copy;
+}
+
+static void set_passage(struct maze_walls *walls, struct coordinate a, struct coordinate b, bool open)
+{
+    unsigned char *cell_a = &walls->cells[maze_cell_index(walls, a.x, a.y)];
+    unsigned char *cell_b = &walls->cells[maze_cell_index(walls, b.x, b.y)];
+    unsigned char passage_a;
+    unsigned char passage_b;
+
+    if (b.x == a.x && b.y + 1 == a.y) {
+        passage_a = PASSAGE_TOP;
+        passage_b = PASSAGE_BOTTOM;
+    } else if (b.x == a.x + 1 && b.y == a.y) {
+        passage_a = PASSAGE_RIGHT;
+        passage_b = PASSAGE_LEFT;
+    } else if (b.x == a.x && b.y == a.y + 1) {
+        passage_a = PASSAGE_BOTTOM;
+        passage_b = PASSAGE_TOP;
+    } else if (b.x + 1 == a.x && b.y == a.y) {
+        passage_a = PASSAGE_LEFT;
+        passage_b = PASSAGE_RIGHT;
+    } else {
+        printf("ERROR: (%d, %d) and (%d, %d) are not adjacent.\n", a.x, a.y, b.x, b.y);
+        exit(1);
+    }
+
+    if (open) {
+        *cell_a |= passage_a;
+        *cell_b |= passage_b;
+    } else {
+        *cell_a &= ~passage_a;
+        *cell_b &= ~passage_b;
+    }
+}
+
+void maze_walls_link(struct maze_walls *walls, struct coordinate a, struct coordinate b)
+{
+    set_passage(walls, a, b, true);
+}
+
+void maze_walls_unlink(struct maze_walls *walls, struct coordinate a, struct coordinate b)
+{
+    set_passage(walls, a, b, false);
+}
+
+int maze_walls_degree(const struct maze_walls *walls, int cell)
+{
+    unsigned char passages = walls->cells[cell];
+    return ((passages & PASSAGE_TOP) != 0)
+        + ((passages & PASSAGE_RIGHT) != 0)
+        + ((passages & PASSAGE_BOTTOM) != 0)
+        + ((passages & PASSAGE_LEFT) != 0);
+}
+
+int **maze_walls_to_graph(const struct maze_walls *walls)
+{
+    int size = walls->size;
+    int total_nodes = size * size;
+
+    int **graph = (int **)calloc(total_nodes, sizeof(int *));
+    for (int i = 0; i < total_nodes; i++)
+    {
+        graph[i] = (int *)calloc(total_nodes, sizeof(int));
+    }
+
+    for (int x = 0; x < size; x++)
+    {
+        for (int y = 0; y < size; y++)
+        {
+            int i = x * size + y;
+            unsigned char passages = walls->cells[maze_cell_index(walls, x, y)];
+
+            if (passages & PASSAGE_TOP)
+                graph[i][i - 1] = 1;
+            if (passages & PASSAGE_RIGHT)
+                graph[i][i + size] = 1;
+            if (passages & PASSAGE_BOTTOM)
+                graph[i][i + 1] = 1;
+            if (passages & PASSAGE_LEFT)
+                graph[i][i - size] = 1;
+        }
+    }
+
+    return graph;
+}
@@ -0,0 +1,85 @@
+//
+//  maze_walls.h
+//  kruskal-maze-generation-c
+//
+//  Created by Ezzat Chamudi on 10/19/26.
+//  Copyright © 2026 Ezzat Chamudi. All rights reserved.
+//  License: Apache-2.0
+//
+
+#ifndef maze_walls_h
+#define maze_walls_h
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include "definitions.h"
+#include "maze_allocator.h"
+#include "morton.h"
+
+// Open passages of a cell
+#define PASSAGE_TOP    0b0001
+#define PASSAGE_RIGHT  0b0010
+#define PASSAGE_BOTTOM 0b0100
+#define PASSAGE_LEFT   0b1000
+
+// Cell storage order. Linear matches the graph ids, x * size + y. Morton
+// (Z-order) keeps 2-D neighbourhoods in nearby cache lines on huge mazes; it
+// pads the grid to a power of two side, so total_cells can exceed size^2.
+#define MAZE_LAYOUT_LINEAR 0
+#define MAZE_LAYOUT_MORTON 1
+
+// Morton indices interleave 16-bit coordinates into an int, so the padded
+// side stops at 2^15
+#define MAZE_MAX_MORTON_SIZE 32768
+
+// Largest size whose size^2 cells still fit an int
+#define MAZE_MAX_SIZE 46340
+
+// Compact maze: one byte of passage flags per cell instead of the
+// total_nodes x total_nodes graph. Generating into it uses the same layout
+// and allocator for the rooms. Mazes are width x height; the generators
+// other than masked_kruskal_walls() only build squares, where size ==
+// width == height. size is 0 for other rectangles.
+struct maze_walls {
+    int size;
+    int width;
+    int height;
+    int layout;
+    int total_cells;
+    unsigned char *cells;
+    const struct maze_allocator *allocator;
+};
+
+static inline int maze_cell_index(const struct maze_walls *walls, int x, int y)
+{
+    if (walls->layout == MAZE_LAYOUT_MORTON)
+        return (int)morton_encode(x, y);
+    return x * walls->height + y;
+}
+
+static inline struct coordinate maze_cell_coordinate(const struct maze_walls *walls, int index)
+{
+    struct coordinate coordinate;
+    if (walls->layout == MAZE_LAYOUT_MORTON) {
+        morton_decode(index, &coordinate.x, &coordinate.y);
+    } else {
+        coordinate.x = index / walls->height;
+        coordinate.y = index % walls->height;
+    }
+    return coordinate;
+}
+
+extern struct maze_walls *maze_walls_create(int size);
+extern struct maze_walls *maze_walls_create_with(int size, int layout, const struct maze_allocator *allocator);
+// Linear layout, up to INT_MAX cells
+extern struct maze_walls *maze_walls_create_rect(int width, int height);
+extern void maze_walls_free(struct maze_walls *walls);
+extern struct maze_walls *maze_walls_copy(const struct maze_walls *walls);
+extern void maze_walls_link(struct maze_walls *walls, struct coordinate a, struct coordinate b);
+extern void maze_walls_unlink(struct maze_walls *walls, struct coordinate a, struct coordinate b);
+extern int maze_walls_degree(const struct maze_walls *walls, int cell);
+extern int **maze_walls_to_graph(const struct maze_walls *walls);
+
+#endif /* maze_walls_h */
@@ -0,0 +1,47 @@
+//
+//  morton.h
+//  kruskal-maze-generation-c
+//
+//  Created by Ezzat Chamudi on 10/19/26.
+//  Copyright © 2026 Ezzat Chamudi. All rights reserved.
+//  License: Apache-2.0
+//
+
+#ifndef morton_h
+#define morton_h
+
+// Z-order bit interleaving for coordinates below 65536: x takes the even
+// bits, y the odd bits. Cells that are close in 2-D stay close in memory.
+
+static inline unsigned int morton_spread(unsigned int value)
+{
+    value &= 0x0000FFFF;
+    value = (value | (value << 8)) & 0x00FF00FF;
+    value = (value | (value << 4)) & 0x0F0F0F0F;
+    value = (value | (value << 2)) & 0x33333333;
+    value = (value | (value << 1)) & 0x55555555;
+    return value;
+}
+
+static inline unsigned int morton_compact(unsigned int value)
+{
+    value &= 0x55555555;
+    value = (value | (value >> 1)) & 0x33333333;
+    value = (value | (value >> 2)) & 0x0F0F0F0F;
+    value = (value | (value >> 4)) & 0x00FF00FF;
+    value = (value | (value >> 8)) & 0x0000FFFF;
+    return value;
+}
+
+static inline unsigned int morton_encode(unsigned int x, unsigned int y)
+{
+    return morton_spread(x) | (morton_spread(y) << 1);
+}
+
+static inline void morton_decode(unsigned int index, unsigned int *x, unsigned int *y)
+{
+    *x = morton_compact(index);
+    *y = morton_compact(index >> 1);
+}
+
+#endif /* morton_h */
@@ -52,3 +52,94 @@ void print_maze(int ** maze_graph, int size) {
     }
     printf("██\n");
 }
+
+void fprint_maze_walls(FILE *stream, const struct maze_walls *walls) {
+    int current_node;
+
+    for (int y = 0; y < walls->height; y++)
+    {
+        for (int x = 0; x < walls->width; x++)
+        {
+            // Check if there's connection to the above node.
+            current_node = maze_cell_index(walls, x, y);
+
+            if (walls->cells[current_node] & PASSAGE_TOP) {
+                fprintf(stream, "██  ");
+            } else {
+                fprintf(stream, "████");
+            }
+        }
+
+        // Right most border
+        fprintf(stream, "██\n");
+
+        for (int x = 0; x < walls->width; x++)
+        {
+            // Check if there's connection to the left node.
+            current_node = maze_cell_index(walls, x, y);
+
+            if (walls->cells[current_node] & PASSAGE_LEFT) {
+                fprintf(stream, "    ");
+            } else {
+                fprintf(stream, "██  ");
+            }
+        }
+
+        // Right most border
+        fprintf(stream, "██\n");
+    }
+
+    // Bottom border
+    for (int i = 0; i < walls->width; i++)
+    {
+        fprintf(stream, "████");
+    }
+    fprintf(stream, "██\n");
+}
+
+// Only the width x height part of walls, with masked cells drawn solid
+void fprint_masked_maze_walls(FILE *stream, const struct maze_walls *walls, const struct maze_mask *mask) {
+    int current_node;
+
+    for (int y = 0; y < mask->height; y++)
+    {
+        for (int x = 0; x < mask->width; x++)
+        {
+            // Check if there's connection to the above node.
+            current_node = maze_cell_index(walls, x, y);
+
+            if (walls->cells[current_node] & PASSAGE_TOP) {
+                fprintf(stream, "██  ");
+            } else {
+                fprintf(stream, "████");
+            }
+        }
+
+        // Right most border
+        fprintf(stream, "██\n");
+
+        for (int x = 0; x < mask->width; x++)
+        {
+            // Check if there's connection to the left node.
+            current_node = maze_cell_index(walls, x, y);
+
+            if (walls->cells[current_node] & PASSAGE_LEFT) {
+                fprintf(stream, "    ");
+            } else if (maze_mask_live(mask, x, y)) {
+                fprintf(stream, "██  ");
+            } else {
+                fprintf(stream, "████");
+            }
+        }
+
+        // Right most border
+        fprintf(stream, "██\n");
+    }
+
+    // Bottom border
+    for (int i = 0; i < mask->width; i++)
+    {
+        fprintf(stream, "████");
+    }
+    fprintf(stream, "██\n");
+}
@@ -12,6 +12,11 @@
 
 #include <stdio.h>
 
+#include "maze_mask.h"
+#include "maze_walls.h"
+
 extern void print_maze(int ** maze_graph, int size);
+extern void fprint_maze_walls(FILE *stream, const struct maze_walls *walls);
+extern void fprint_masked_maze_walls(FILE *stream, const struct maze_walls *walls, const struct maze_mask *mask);
 
 #endif
@@ -0,0 +1,685 @@
+//
+//  kruskal_maze.c
+//  kruskal-maze-generation-c
+//
+//  Created by Ezzat Chamudi on 10/19/26.
+//  Copyright © 2026 Ezzat Chamudi. All rights reserved.
+//  License: Apache-2.0
+//
+
+// Python bindings. Mazes and batches expose their passage flags through the
+// buffer protocol (uint8, indexed [x, y] or [maze, x, y]), so NumPy views
+// them without copying. Generation runs with the GIL released.
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+#include <limits.h>
+#include <pthread.h>
+#include <time.h>
+
+#include "../definitions.h"
+#include "../maze_archive.h"
+#include "../maze_walls.h"
+#include "../randomized_kruskal.h"
+#include "../rng.h"
+#include "../seed_search.h"
+#include "../stats.h"
+
+static unsigned long long seed_counter = 0;
+
+static bool parse_seed(PyObject *seed_object, unsigned long long *seed)
+{
+    if (seed_object == NULL || seed_object == Py_None)
+    {
+        // Called with the GIL held, so the counter needs no lock
+        *seed = rng_derive((unsigned long long)time(NULL), seed_counter++);
+        return true;
+    }
+
+    *seed = PyLong_AsUnsignedLongLongMask(seed_object);
+    return !PyErr_Occurred();
+}
+
+static bool check_maze_arguments(int size, unsigned int direction_options)
+{
+    // Options without standard links can fail to join all rooms, which
+    // would exit() the interpreter
+    if (size < 2)
+    {
+        PyErr_SetString(PyExc_ValueError, "size must be at least 2");
+        return false;
+    }
+
+    // Larger sizes overflow the int cell indices
+    if (size > MAZE_MAX_SIZE)
+    {
+        PyErr_Format(PyExc_ValueError, "size must be at most %d", MAZE_MAX_SIZE);
+        return false;
+    }
+
+    if (!(direction_options & ENABLE_STANDARD)
+        || (direction_options & ~(unsigned int)(ENABLE_STANDARD | ENABLE_DIAGONAL | ENABLE_LETTERS | UNIFORM_SAMPLING | LETTER_PREPASS)))
+    {
+        PyErr_SetString(PyExc_ValueError, "options must include STANDARD (0b001) and only known flags");
+        return false;
+    }
+
+    return true;
+}
+
+static int fill_buffer(PyObject *exporter, Py_buffer *view, int flags, void *buf, int ndim, Py_ssize_t *shape, Py_ssize_t *strides)
+{
+    if (flags & PyBUF_WRITABLE)
+    {
+        PyErr_SetString(PyExc_BufferError, "maze buffers are read-only");
+        view->obj = NULL;
+        return -1;
+    }
+
+    Py_ssize_t len = 1;
+    for (int i = 0; i < ndim; i++)
+        len *= shape[i];
+
+    Py_INCREF(exporter);
+    view->obj = exporter;
+    view->buf = buf;
+    view->len = len;
+    view->readonly = 1;
+    view->itemsize = 1;
+    view->format = (flags & PyBUF_FORMAT) ? "B" : NULL;
+    view->ndim = ndim;
+    view->shape = (flags & PyBUF_ND) ? shape : NULL;
+    view->strides = (flags & PyBUF_STRIDES) == PyBUF_STRIDES ? strides : NULL;
+    view->suboffsets = NULL;
+    view->internal = NULL;
+
+    return 0;
+}
+
+// Maze
+
+typedef struct {
+    PyObject_HEAD
+    struct maze_walls *walls;
+    struct maze result;
+    Py_ssize_t shape[2];
+    Py_ssize_t strides[2];
+} MazeObject;
+
+static void Maze_dealloc(MazeObject *self)
+{
+    if (self->walls)
+        maze_walls_free(self->walls);
+    Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+static int Maze_getbuffer(MazeObject *self, Py_buffer *view, int flags)
+{
+    return fill_buffer((PyObject *)self, view, flags, self->walls->cells, 2, self->shape, self->strides);
+}
+
+static PyBufferProcs Maze_as_buffer = {
+    .bf_getbuffer = (getbufferproc)Maze_getbuffer,
+};
+
+static PyObject *Maze_get_size(MazeObject *self, void *closure)
+{
+    return PyLong_FromLong(self->walls->size);
+}
+
+static PyObject *Maze_get_passes(MazeObject *self, void *closure)
+{
+    return PyLong_FromLong(self->result.total_passes);
+}
+
+static PyObject *Maze_get_failed_passes(MazeObject *self, void *closure)
+{
+    return PyLong_FromLong(self->result.total_failed_passes);
+}
+
+static PyObject *Maze_get_degrees(MazeObject *self, void *closure)
+{
+    return Py_BuildValue("(iiii)",
+                         self->result.total_deg1_nodes,
+                         self->result.total_deg2_nodes,
+                         self->result.total_deg3_nodes,
+                         self->result.total_deg4_nodes);
+}
+
+static PyGetSetDef Maze_getset[] = {
+    {"size", (getter)Maze_get_size, NULL, "Cells per side", NULL},
+    {"passes", (getter)Maze_get_passes, NULL, "Generation passes", NULL},
+    {"failed_passes", (getter)Maze_get_failed_passes, NULL, "Passes without a legal direction", NULL},
+    {"degrees", (getter)Maze_get_degrees, NULL, "Cells of degree 1, 2, 3 and 4", NULL},
+    {NULL}
+};
+
+static PyTypeObject MazeType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "kruskal_maze.Maze",
+    .tp_doc = "Generated maze; a read-only uint8 buffer of passage flags indexed [x, y]",
+    .tp_basicsize = sizeof(MazeObject),
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_dealloc = (destructor)Maze_dealloc,
+    .tp_as_buffer = &Maze_as_buffer,
+    .tp_getset = Maze_getset,
+};
+
+static PyObject *kruskal_generate(PyObject *module, PyObject *args, PyObject *kwargs)
+{
+    static char *keywords[] = {"size", "options", "seed", NULL};
+
+    int size;
+    unsigned int direction_options = ENABLE_STANDARD | ENABLE_DIAGONAL | ENABLE_LETTERS;
+    PyObject *seed_object = NULL;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "i|IO", keywords, &size, &direction_options, &seed_object))
+        return NULL;
+
+    unsigned long long seed;
+    if (!check_maze_arguments(size, direction_options) || !parse_seed(seed_object, &seed))
+        return NULL;
+
+    MazeObject *maze = PyObject_New(MazeObject, &MazeType);
+    if (maze == NULL)
+        return NULL;
+
+    maze->walls = NULL;
+
+    Py_BEGIN_ALLOW_THREADS
+    struct rng rng;
+    rng_seed(&rng, seed);
+
+    maze->walls = maze_walls_create(size);
+    maze->result = randomized_kruskal_walls(false, maze->walls, direction_options, &rng, NULL);
+    Py_END_ALLOW_THREADS
+
+    maze->shape[0] = size;
+    maze->shape[1] = size;
+    maze->strides[0] = size;
+    maze->strides[1] = 1;
+
+    return (PyObject *)maze;
+}
+
+// Batch
+
+typedef struct {
+    PyObject_HEAD
+    unsigned char *cells;
+    int total_mazes;
+    int size;
+    Py_ssize_t shape[3];
+    Py_ssize_t strides[3];
+} MazeBatchObject;
+
+static void MazeBatch_dealloc(MazeBatchObject *self)
+{
+    free(self->cells);
+    Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+static int MazeBatch_getbuffer(MazeBatchObject *self, Py_buffer *view, int flags)
+{
+    return fill_buffer((PyObject *)self, view, flags, self->cells, 3, self->shape, self->strides);
+}
+
+static PyBufferProcs MazeBatch_as_buffer = {
+    .bf_getbuffer = (getbufferproc)MazeBatch_getbuffer,
+};
+
+static Py_ssize_t MazeBatch_length(MazeBatchObject *self)
+{
+    return self->total_mazes;
+}
+
+static PySequenceMethods MazeBatch_as_sequence = {
+    .sq_length = (lenfunc)MazeBatch_length,
+};
+
+static PyObject *MazeBatch_get_size(MazeBatchObject *self, void *closure)
+{
+    return PyLong_FromLong(self->size);
+}
+
+static PyGetSetDef MazeBatch_getset[] = {
+    {"size", (getter)MazeBatch_get_size, NULL, "Cells per side of every maze", NULL},
+    {NULL}
+};
+
+static PyTypeObject MazeBatchType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "kruskal_maze.MazeBatch",
+    .tp_doc = "Generated mazes; a read-only uint8 buffer of passage flags indexed [maze, x, y]",
+    .tp_basicsize = sizeof(MazeBatchObject),
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_dealloc = (destructor)MazeBatch_dealloc,
+    .tp_as_buffer = &MazeBatch_as_buffer,
+    .tp_as_sequence = &MazeBatch_as_sequence,
+    .tp_getset = MazeBatch_getset,
+};
+
+static MazeBatchObject *new_batch(int total_mazes, int size)
+{
+    MazeBatchObject *batch = PyObject_New(MazeBatchObject, &MazeBatchType);
+    if (batch == NULL)
+        return NULL;
+
+    batch->total_mazes = total_mazes;
+    batch->size = size;
+    batch->cells = (unsigned char *)malloc((size_t)total_mazes * size * size + 1);
+    if (batch->cells == NULL)
+    {
+        Py_DECREF(batch);
+        PyErr_NoMemory();
+        return NULL;
+    }
+
+    batch->shape[0] = total_mazes;
+    batch->shape[1] = size;
+    batch->shape[2] = size;
+    batch->strides[0] = (Py_ssize_t)size * size;
+    batch->strides[1] = size;
+    batch->strides[2] = 1;
+
+    return batch;
+}
+
+struct batch_job {
+    unsigned char *cells;
+    int total_mazes;
+    int size;
+    unsigned int direction_options;
+    unsigned long long seed;
+    int thread;
+    int total_threads;
+    bool threaded;
+};
+
+static void *generate_batch_thread(void *argument)
+{
+    struct batch_job *job = (struct batch_job *)argument;
+    size_t maze_bytes = (size_t)job->size * job->size;
+
+    struct maze_walls *walls = maze_walls_create(job->size);
+
+    // Maze i always comes from seed (seed, i), whatever the thread count
+    for (int i = job->thread; i < job->total_mazes; i += job->total_threads)
+    {
+        struct rng rng;
+        rng_seed(&rng, rng_derive(job->seed, i));
+
+        memset(walls->cells, 0, maze_bytes);
+        randomized_kruskal_walls(false, walls, job->direction_options, &rng, NULL);
+        memcpy(job->cells + maze_bytes * i, walls->cells, maze_bytes);
+    }
+
+    maze_walls_free(walls);
+    return NULL;
+}
+
+static PyObject *kruskal_generate_batch(PyObject *module, PyObject *args, PyObject *kwargs)
+{
+    static char *keywords[] = {"count", "size", "options", "seed", "threads", NULL};
+
+    int total_mazes;
+    int size;
+    unsigned int direction_options = ENABLE_STANDARD | ENABLE_DIAGONAL | ENABLE_LETTERS;
+    PyObject *seed_object = NULL;
+    int total_threads = 1;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "ii|IOi", keywords,
+                                     &total_mazes, &size, &direction_options, &seed_object, &total_threads))
+        return NULL;
+
+    unsigned long long seed;
+    if (!check_maze_arguments(size, direction_options) || !parse_seed(seed_object, &seed))
+        return NULL;
+
+    if (total_mazes < 0 || total_threads < 1)
+    {
+        PyErr_SetString(PyExc_ValueError, "count must be >= 0 and threads >= 1");
+        return NULL;
+    }
+
+    MazeBatchObject *batch = new_batch(total_mazes, size);
+    if (batch == NULL)
+        return NULL;
+
+    if (total_threads > total_mazes)
+        total_threads = total_mazes > 0 ? total_mazes : 1;
+
+    struct batch_job *jobs = (struct batch_job *)calloc(total_threads, sizeof(struct batch_job));
+    pthread_t *threads = (pthread_t *)calloc(total_threads, sizeof(pthread_t));
+
+    if (jobs == NULL || threads == NULL)
+    {
+        free(jobs);
+        free(threads);
+        Py_DECREF(batch);
+        return PyErr_NoMemory();
+    }
+
+    Py_BEGIN_ALLOW_THREADS
+    for (int t = 0; t < total_threads; t++)
+    {
+        jobs[t].cells = batch->cells;
+        jobs[t].total_mazes = total_mazes;
+        jobs[t].size = size;
+        jobs[t].direction_options = direction_options;
+        jobs[t].seed = seed;
+        jobs[t].thread = t;
+        jobs[t].total_threads = total_threads;
+
+        if (t > 0)
+            jobs[t].threaded = pthread_create(&threads[t], NULL, generate_batch_thread, &jobs[t]) == 0;
+    }
+
+    // Jobs whose thread couldn't be started run here, so the batch is
+    // still complete
+    for (int t = 0; t < total_threads; t++)
+    {
+        if (!jobs[t].threaded)
+            generate_batch_thread(&jobs[t]);
+    }
+
+    for (int t = 1; t < total_threads; t++)
+    {
+        if (jobs[t].threaded)
+            pthread_join(threads[t], NULL);
+    }
+    Py_END_ALLOW_THREADS
+
+    free(jobs);
+    free(threads);
+
+    return (PyObject *)batch;
+}
+
+// Archives
+
+static PyObject *kruskal_write_archive(PyObject *module, PyObject *args, PyObject *kwargs)
+{
+    static char *keywords[] = {"path", "count", "size", "options", "seed", "threads", "block", NULL};
+
+    const char *path;
+    long long total_mazes;
+    int size;
+    unsigned int direction_options = ENABLE_STANDARD | ENABLE_DIAGONAL | ENABLE_LETTERS;
+    PyObject *seed_object = NULL;
+    int total_threads = 1;
+    int mazes_per_block = MAZE_ARCHIVE_BLOCK_MAZES;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "sLi|IOii", keywords, &path, &total_mazes, &size,
+                                     &direction_options, &seed_object, &total_threads, &mazes_per_block))
+        return NULL;
+
+    unsigned long long seed;
+    if (!check_maze_arguments(size, direction_options) || !parse_seed(seed_object, &seed))
+        return NULL;
+
+    if (total_mazes < 0 || total_threads < 1 || mazes_per_block < 1)
+    {
+        PyErr_SetString(PyExc_ValueError, "count must be >= 0, threads and block >= 1");
+        return NULL;
+    }
+
+    FILE *file = fopen(path, "wb");
+    if (file == NULL)
+        return PyErr_SetFromErrnoWithFilename(PyExc_OSError, path);
+
+    bool written;
+    Py_BEGIN_ALLOW_THREADS
+    written = maze_archive_generate(file, size, direction_options, seed, total_mazes, mazes_per_block, total_threads);
+    written = fclose(file) == 0 && written;
+    Py_END_ALLOW_THREADS
+
+    if (!written)
+    {
+        PyErr_Format(PyExc_OSError, "can't write archive %s", path);
+        return NULL;
+    }
+
+    Py_RETURN_NONE;
+}
+
+static PyObject *kruskal_read_archive(PyObject *module, PyObject *args, PyObject *kwargs)
+{
+    static char *keywords[] = {"path", "threads", NULL};
+
+    const char *path;
+    int total_threads = 1;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "s|i", keywords, &path, &total_threads))
+        return NULL;
+
+    FILE *file = fopen(path, "rb");
+    if (file == NULL)
+        return PyErr_SetFromErrnoWithFilename(PyExc_OSError, path);
+
+    struct maze_archive *archive = maze_archive_open(file);
+    if (archive == NULL || archive->total_mazes > INT_MAX)
+    {
+        maze_archive_close(archive);
+        fclose(file);
+        PyErr_Format(PyExc_ValueError, "%s is not a maze archive this module can load", path);
+        return NULL;
+    }
+
+    MazeBatchObject *batch = new_batch((int)archive->total_mazes, archive->size);
+
+    bool valid = false;
+    if (batch != NULL)
+    {
+        Py_BEGIN_ALLOW_THREADS
+        valid = maze_archive_read_all(archive, batch->cells, total_threads);
+        Py_END_ALLOW_THREADS
+    }
+
+    maze_archive_close(archive);
+    fclose(file);
+
+    if (batch != NULL && !valid)
+    {
+        Py_DECREF(batch);
+        PyErr_Format(PyExc_ValueError, "%s is corrupt", path);
+        return NULL;
+    }
+
+    return (PyObject *)batch;
+}
+
+// Seed search
+
+static PyObject *kruskal_search(PyObject *module, PyObject *args, PyObject *kwargs)
+{
+    static char *keywords[] = {"size", "conditions", "count", "options", "first_seed", "limit", "threads", NULL};
+
+    int size;
+    PyObject *conditions;
+    int wanted = 1;
+    unsigned int direction_options = ENABLE_STANDARD | ENABLE_DIAGONAL | ENABLE_LETTERS;
+    unsigned long long first_seed = 0;
+    long long total_seeds = 0;
+    int total_threads = 1;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "iO|iIKLi", keywords, &size, &conditions, &wanted,
+                                     &direction_options, &first_seed, &total_seeds, &total_threads))
+        return NULL;
+
+    if (!check_maze_arguments(size, direction_options))
+        return NULL;
+
+    if (size < 2 || wanted < 1 || total_threads < 1)
+    {
+        PyErr_SetString(PyExc_ValueError, "size must be >= 2, count and threads >= 1");
+        return NULL;
+    }
+
+    struct seed_predicate predicate;
+    seed_predicate_init(&predicate);
+
+    PyObject *sequence = PySequence_Fast(conditions, "conditions must be a sequence of strings");
+    if (sequence == NULL)
+        return NULL;
+
+    for (Py_ssize_t i = 0; i < PySequence_Fast_GET_SIZE(sequence); i++)
+    {
+        const char *condition = PyUnicode_AsUTF8(PySequence_Fast_GET_ITEM(sequence, i));
+        if (condition == NULL || !seed_predicate_add(&predicate, condition))
+        {
+            if (condition != NULL)
+                PyErr_Format(PyExc_ValueError, "bad condition %s", condition);
+            Py_DECREF(sequence);
+            return NULL;
+        }
+    }
+    Py_DECREF(sequence);
+
+    struct seed_match *matches = (struct seed_match *)calloc(wanted, sizeof(struct seed_match));
+    if (matches == NULL)
+        return PyErr_NoMemory();
+
+    int total_matches;
+    Py_BEGIN_ALLOW_THREADS
+    total_matches = seed_search(size, direction_options, &predicate, first_seed, total_seeds, wanted, total_threads,
+                                matches, NULL);
+    Py_END_ALLOW_THREADS
+
+    PyObject *list = PyList_New(total_matches);
+    for (int i = 0; list != NULL && i < total_matches; i++)
+    {
+        PyObject *item = Py_BuildValue("{s:K}", "seed", matches[i].seed);
+        for (int j = 0; item != NULL && j < TOTAL_SEARCH_METRICS; j++)
+        {
+            PyObject *value = PyLong_FromLong(matches[i].metrics[j]);
+            if (value == NULL || PyDict_SetItemString(item, seed_metric_names[j], value) < 0)
+                Py_CLEAR(item);
+            Py_XDECREF(value);
+        }
+
+        if (item == NULL)
+            Py_CLEAR(list);
+        else
+            PyList_SET_ITEM(list, i, item);
+    }
+
+    free(matches);
+    return list;
+}
+
+// Stats
+
+static PyObject *kruskal_stats(PyObject *module, PyObject *args, PyObject *kwargs)
+{
+    static char *keywords[] = {"options", "size", "trials", "backend", "seed", NULL};
+
+    unsigned int direction_options = ENABLE_STANDARD;
+    int size = 10;
+    int trials = 100000;
+    const char *backend_name = "serial";
+    PyObject *seed_object = NULL;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|IiisO", keywords,
+                                     &direction_options, &size, &trials, &backend_name, &seed_object))
+        return NULL;
+
+    unsigned long long seed;
+    if (!check_maze_arguments(size, direction_options) || !parse_seed(seed_object, &seed))
+        return NULL;
+
+    int backend;
+    if (strcmp(backend_name, "serial") == 0)
+    {
+        backend = STATS_SERIAL;
+    }
+    else if (strcmp(backend_name, "batch") == 0)
+    {
+        backend = STATS_BATCH;
+        if (size > BATCH_MAX_SIZE || (direction_options & (UNIFORM_SAMPLING | LETTER_PREPASS)))
+        {
+            PyErr_Format(PyExc_ValueError, "batch backend needs size <= %d and no uniform sampling or pre-pass", BATCH_MAX_SIZE);
+            return NULL;
+        }
+    }
+    else
+    {
+        PyErr_SetString(PyExc_ValueError, "backend must be 'serial' or 'batch'");
+        return NULL;
+    }
+
+    if (trials < 1)
+    {
+        PyErr_SetString(PyExc_ValueError, "trials must be at least 1");
+        return NULL;
+    }
+
+    struct stats_result result;
+
+    Py_BEGIN_ALLOW_THREADS
+    stats_run(size, trials, direction_options, backend, seed, &result);
+    Py_END_ALLOW_THREADS
+
+    return Py_BuildValue("{s:d,s:d,s:d,s:d,s:d,s:d,s:d}",
+                         "avg_deg1_nodes", result.avg_deg1_nodes,
+                         "avg_deg2_nodes", result.avg_deg2_nodes,
+                         "avg_deg3_nodes", result.avg_deg3_nodes,
+                         "avg_deg4_nodes", result.avg_deg4_nodes,
+                         "avg_passes", result.avg_passes,
+                         "avg_failed_passes", result.avg_failed_passes,
+                         "mazes_per_second", result.mazes_per_second);
+}
+
+static PyMethodDef kruskal_methods[] = {
+    {"generate", (PyCFunction)(void (*)(void))kruskal_generate, METH_VARARGS | METH_KEYWORDS,
+     "generate(size, options=0b111, seed=None) -> Maze"},
+    {"generate_batch", (PyCFunction)(void (*)(void))kruskal_generate_batch, METH_VARARGS | METH_KEYWORDS,
+     "generate_batch(count, size, options=0b111, seed=None, threads=1) -> MazeBatch"},
+    {"write_archive", (PyCFunction)(void (*)(void))kruskal_write_archive, METH_VARARGS | METH_KEYWORDS,
+     "write_archive(path, count, size, options=0b111, seed=None, threads=1, block=1024); same mazes as generate_batch"},
+    {"read_archive", (PyCFunction)(void (*)(void))kruskal_read_archive, METH_VARARGS | METH_KEYWORDS,
+     "read_archive(path, threads=1) -> MazeBatch"},
+    {"search", (PyCFunction)(void (*)(void))kruskal_search, METH_VARARGS | METH_KEYWORDS,
+     "search(size, conditions, count=1, options=0b111, first_seed=0, limit=0, threads=1) -> [dict]; "
+     "the first count seeds whose generate() maze meets every condition, e.g. ['deg1>=30', 'solution=40..60']"},
+    {"stats", (PyCFunction)(void (*)(void))kruskal_stats, METH_VARARGS | METH_KEYWORDS,
+     "stats(options=0b001, size=10, trials=100000, backend='serial', seed=None) -> dict"},
+    {NULL, NULL, 0, NULL}
+};
+
+static struct PyModuleDef kruskal_module = {
+    PyModuleDef_HEAD_INIT,
+    .m_name = "kruskal_maze",
+    .m_doc = "Randomized Kruskal maze generation",
+    .m_size = -1,
+    .m_methods = kruskal_methods,
+};
+
+PyMODINIT_FUNC PyInit_kruskal_maze(void)
+{
+    if (PyType_Ready(&MazeType) < 0 || PyType_Ready(&MazeBatchType) < 0)
+        return NULL;
+
+    PyObject *module = PyModule_Create(&kruskal_module);
+    if (module == NULL)
+        return NULL;
+
+    Py_INCREF(&MazeType);
+    PyModule_AddObject(module, "Maze", (PyObject *)&MazeType);
+    Py_INCREF(&MazeBatchType);
+    PyModule_AddObject(module, "MazeBatch", (PyObject *)&MazeBatchType);
+
+    PyModule_AddIntConstant(module, "PASSAGE_TOP", PASSAGE_TOP);
+    PyModule_AddIntConstant(module, "PASSAGE_RIGHT", PASSAGE_RIGHT);
+    PyModule_AddIntConstant(module, "PASSAGE_BOTTOM", PASSAGE_BOTTOM);
+    PyModule_AddIntConstant(module, "PASSAGE_LEFT", PASSAGE_LEFT);
+
+    PyModule_AddIntConstant(module, "STANDARD", ENABLE_STANDARD);
+    PyModule_AddIntConstant(module, "DIAGONAL", ENABLE_DIAGONAL);
+    PyModule_AddIntConstant(module, "LETTERS", ENABLE_LETTERS);
+    PyModule_AddIntConstant(module, "UNIFORM", UNIFORM_SAMPLING);
+    PyModule_AddIntConstant(module, "PREPASS", LETTER_PREPASS);
+
+    return module;
+}
@@ -0,0 +1,50 @@
+# Builds the kruskal_maze extension from the C sources one directory up:
+#   cd python && python3 setup.py build_ext --inplace
+#
+# The build runs on any CPU of the same architecture, and the batch kernel
+# uses plain lanes. KRUSKAL_MAZE_NATIVE=1 builds for this machine's CPU
+# (AVX2 or AVX-512 lanes where it has them); the result may crash with
+# SIGILL on older CPUs, so don't ship it.
+
+import os
+
+from setuptools import Extension, setup
+
+ROOT = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..")
+
+COMPILE_ARGS = ["-O2"]
+if os.environ.get("KRUSKAL_MAZE_NATIVE") == "1":
+    COMPILE_ARGS.append("-march=native")
+
+SOURCES = [
+    "batch_kruskal.c",
+    "bitboard_kruskal.c",
+    "definitions.c",
+    "event_log.c",
+    "fenwick.c",
+    "letter_prepass.c",
+    "maze_allocator.c",
+    "maze_archive.c",
+    "maze_walls.c",
+    "print_maze.c",
+    "print_maze_draft.c",
+    "randomized_kruskal.c",
+    "rng.c",
+    "seed_search.c",
+    "stats.c",
+    "uniform_kruskal.c",
+    "util.c",
+]
+
+setup(
+    name="kruskal_maze",
+    version="1.0",
+    ext_modules=[
+        Extension(
+            "kruskal_maze",
+            sources=["kruskal_maze.c"] + [os.path.relpath(os.path.join(ROOT, source)) for source in SOURCES],
+            extra_compile_args=COMPILE_ARGS,
+            extra_link_args=["-lpthread"],
+        )
+    ],
+)
@@ -9,11 +9,11 @@
 
 #include "randomized_kruskal.h"
 
-unsigned char *available_directions(int x, int y, int **maze_draft, int size, unsigned int options)
+int legal_directions(unsigned char *directions, int x, int y, int size, unsigned int options, int rooms[3][3])
 {
-    const unsigned int enable_standard = 0b00000001;
-    const unsigned int enable_diagonal = 0b00000010;
-    const unsigned int enable_letters  = 0b00000100;
+    const unsigned int enable_standard = ENABLE_STANDARD;
+    const unsigned int enable_diagonal = ENABLE_DIAGONAL;
+    const unsigned int enable_letters  = ENABLE_LETTERS;
 
     int legality_counter = 0;
 
@@ -30,7 +30,7 @@ unsigned char *available_directions(int x, int y, int **maze_draft, int size, un
     if ((options & enable_diagonal)
         && !near_top_border
         && !near_left_border
-        && all_unique_3(maze_draft[x][y], maze_draft[x][y - 1], maze_draft[x - 1][y - 1]))
+        && all_unique_3(rooms[1][1], rooms[1][0], rooms[0][0]))
     {
         legality[TOP_LEFT] = true;
         legality_counter++;
@@ -39,7 +39,7 @@ unsigned char *available_directions(int x, int y, int **maze_draft, int size, un
     // Check top
     if ((options & enable_standard)
         && !near_top_border
-        && (maze_draft[x][y] != maze_draft[x][y - 1]))
+        && (rooms[1][1] != rooms[1][0]))
     {
         legality[TOP] = true;
         legality_counter++;
@@ -49,7 +49,7 @@ unsigned char *available_directions(int x, int y, int **maze_draft, int size, un
     if ((options & enable_diagonal)
         && !near_top_border
         && !near_right_border
-        && all_unique_3(maze_draft[x][y], maze_draft[x][y - 1], maze_draft[x + 1][y - 1]))
+        && all_unique_3(rooms[1][1], rooms[1][0], rooms[2][0]))
     {
         legality[TOP_RIGHT] = true;
         legality_counter++;
@@ -59,7 +59,7 @@ unsigned char *available_directions(int x, int y, int **maze_draft, int size, un
     if ((options & enable_diagonal)
         && !near_right_border
         && !near_top_border
-        && all_unique_3(maze_draft[x][y], maze_draft[x + 1][y], maze_draft[x + 1][y - 1]))
+        && all_unique_3(rooms[1][1], rooms[2][1], rooms[2][0]))
     {
         legality[RIGHT_TOP] = true;
         legality_counter++;
@@ -68,7 +68,7 @@ unsigned char *available_directions(int x, int y, int **maze_draft, int size, un
     // Check right
     if ((options & enable_standard)
         && !near_right_border
-        && (maze_draft[x][y] != maze_draft[x + 1][y]))
+        && (rooms[1][1] != rooms[2][1]))
     {
         legality[RIGHT] = true;
         legality_counter++;
@@ -78,7 +78,7 @@ unsigned char *available_directions(int x, int y, int **maze_draft, int size, un
     if ((options & enable_diagonal)
         && !near_right_border
         && !near_bottom_border
-        && all_unique_3(maze_draft[x][y], maze_draft[x + 1][y], maze_draft[x + 1][y + 1]))
+        && all_unique_3(rooms[1][1], rooms[2][1], rooms[2][2]))
     {
         legality[RIGHT_BOTTOM] = true;
         legality_counter++;
@@ -88,7 +88,7 @@ unsigned char *available_directions(int x, int y, int **maze_draft, int size, un
     if ((options & enable_diagonal)
         && !near_bottom_border
         && !near_right_border
-        && all_unique_3(maze_draft[x][y], maze_draft[x][y + 1], maze_draft[x + 1][y + 1]))
+        && all_unique_3(rooms[1][1], rooms[1][2], rooms[2][2]))
     {
         legality[BOTTOM_RIGHT] = true;
         legality_counter++;
@@ -97,7 +97,7 @@ unsigned char *available_directions(int x, int y, int **maze_draft, int size, un
     // Check bottom
     if ((options & enable_standard)
         && !near_bottom_border
-        && (maze_draft[x][y] != maze_draft[x][y + 1]))
+        && (rooms[1][1] != rooms[1][2]))
     {
         legality[BOTTOM] = true;
         legality_counter++;
@@ -107,7 +107,7 @@ unsigned char *available_directions(int x, int y, int **maze_draft, int size, un
     if ((options & enable_diagonal)
         && !near_bottom_border
         && !near_left_border
-        && all_unique_3(maze_draft[x][y], maze_draft[x][y + 1], maze_draft[x - 1][y + 1]))
+        && all_unique_3(rooms[1][1], rooms[1][2], rooms[0][2]))
     {
         legality[BOTTOM_LEFT] = true;
         legality_counter++;
@@ -117,7 +117,7 @@ unsigned char *available_directions(int x, int y, int **maze_draft, int size, un
     if ((options & enable_diagonal)
         && !near_left_border
         && !near_bottom_border
-        && all_unique_3(maze_draft[x][y], maze_draft[x - 1][y], maze_draft[x - 1][y + 1]))
+        && all_unique_3(rooms[1][1], rooms[0][1], rooms[0][2]))
     {
         legality[LEFT_BOTTOM] = true;
         legality_counter++;
@@ -126,7 +126,7 @@ unsigned char *available_directions(int x, int y, int **maze_draft, int size, un
     // Check left
     if ((options & enable_standard)
         && !near_left_border
-        && (maze_draft[x][y] != maze_draft[x - 1][y]))
+        && (rooms[1][1] != rooms[0][1]))
     {
         legality[LEFT] = true;
         legality_counter++;
@@ -136,7 +136,7 @@ unsigned char *available_directions(int x, int y, int **maze_draft, int size, un
     if ((options & enable_diagonal)
         && !near_left_border
         && !near_top_border
-        && all_unique_3(maze_draft[x][y], maze_draft[x - 1][y], maze_draft[x - 1][y - 1]))
+        && all_unique_3(rooms[1][1], rooms[0][1], rooms[0][0]))
     {
         legality[LEFT_TOP] = true;
         legality_counter++;
@@ -149,17 +149,17 @@ unsigned char *available_directions(int x, int y, int **maze_draft, int size, un
         && !near_border)
     {
         int rooms_S[9] = {
-            maze_draft[x - 1][y - 1],
-            maze_draft[x][y - 1],
-            maze_draft[x + 1][y - 1],
+            rooms[0][0],
+            rooms[1][0],
+            rooms[2][0],
             
-            maze_draft[x - 1][y],
-            maze_draft[x][y],
-            maze_draft[x + 1][y],
+            rooms[0][1],
+            rooms[1][1],
+            rooms[2][1],
             
-            maze_draft[x - 1][y + 1],
-            maze_draft[x][y + 1],
-            maze_draft[x + 1][y + 1]
+            rooms[0][2],
+            rooms[1][2],
+            rooms[2][2]
         };
 
         if (all_unique_array(9, rooms_S)) {
@@ -168,87 +168,391 @@ unsigned char *available_directions(int x, int y, int **maze_draft, int size, un
         }
     }
 
-    unsigned char *array = (unsigned char *)calloc(legality_counter + 1, sizeof(unsigned char));
-
-    array[0] = legality_counter; // First element shows how many items are legal
+    directions[0] = legality_counter; // First element shows how many items are legal
 
     int index = 1;
     for (int i = 0; i < TOTAL_DIRECTIONS; i++)
     {
         if (legality[i])
         {
-            array[index] = i;
+            directions[index] = i;
             index++;
         };
     }
 
+    return legality_counter;
+}
+
+unsigned char *available_directions(int x, int y, int **maze_draft, int size, unsigned int options)
+{
+    // Rooms around (x, y); cells outside the grid are never read by legal_directions
+    int rooms[3][3];
+
+    for (int dx = -1; dx <= 1; dx++)
+    {
+        for (int dy = -1; dy <= 1; dy++)
+        {
+            bool inside = x + dx >= 0 && x + dx < size && y + dy >= 0 && y + dy < size;
+            rooms[dx + 1][dy + 1] = inside ? maze_draft[x + dx][y + dy] : -1;
+        }
+    }
+
+    unsigned char legal[TOTAL_DIRECTIONS + 1];
+    int legality_counter = legal_directions(legal, x, y, size, options, rooms);
+
+    unsigned char *array = (unsigned char *)calloc(legality_counter + 1, sizeof(unsigned char));
+
+    for (int i = 0; i < legality_counter + 1; i++)
+    {
+        array[i] = legal[i];
+    }
+
     return array;
 }
 
-struct maze randomized_kruskal(bool verbose, int size, unsigned int direction_options)
+int direction_nodes(struct coordinate *selected_nodes, struct coordinate node_mid, int direction)
 {
-    struct maze result;
+    switch (direction)
+    {
+    case TOP:
+    case RIGHT:
+    case BOTTOM:
+    case LEFT:
+        selected_nodes[0] = node_mid;
 
-    const int total_nodes = size * size;
+        switch (direction)
+        {
+        case TOP:
+            selected_nodes[1].x = node_mid.x;
+            selected_nodes[1].y = node_mid.y - 1;
+            break;
+        case RIGHT:
+            selected_nodes[1].x = node_mid.x + 1;
+            selected_nodes[1].y = node_mid.y;
+            break;
+        case BOTTOM:
+            selected_nodes[1].x = node_mid.x;
+            selected_nodes[1].y = node_mid.y + 1;
+            break;
+        case LEFT:
+            selected_nodes[1].x = node_mid.x - 1;
+            selected_nodes[1].y = node_mid.y;
+            break;
+        default:
+            break;
+        }
 
-    // Create maze draft
-    int **maze_draft = (int **)calloc(size, sizeof(int *));
-    for (int i = 0; i < size; i++)
+        return 2;
+    case TOP_LEFT:
+    case TOP_RIGHT:
+    case RIGHT_TOP:
+    case RIGHT_BOTTOM:
+    case BOTTOM_RIGHT:
+    case BOTTOM_LEFT:
+    case LEFT_BOTTOM:
+    case LEFT_TOP:
+        selected_nodes[0] = node_mid;
+
+        switch (direction)
+        {
+        case TOP_LEFT:
+        case TOP_RIGHT:
+            selected_nodes[1].x = node_mid.x;
+            selected_nodes[1].y = node_mid.y - 1;
+            break;
+        case RIGHT_TOP:
+        case RIGHT_BOTTOM:
+            selected_nodes[1].x = node_mid.x + 1;
+            selected_nodes[1].y = node_mid.y;
+            break;
+        case BOTTOM_LEFT:
+        case BOTTOM_RIGHT:
+            selected_nodes[1].x = node_mid.x;
+            selected_nodes[1].y = node_mid.y + 1;
+            break;
+        case LEFT_TOP:
+        case LEFT_BOTTOM:
+            selected_nodes[1].x = node_mid.x - 1;
+            selected_nodes[1].y = node_mid.y;
+            break;
+        default:
+            break;
+        }
+
+        switch (direction)
+        {
+        case TOP_LEFT:
+        case LEFT_TOP:
+            selected_nodes[2].x = node_mid.x - 1;
+            selected_nodes[2].y = node_mid.y - 1;
+            break;
+        case TOP_RIGHT:
+        case RIGHT_TOP:
+            selected_nodes[2].x = node_mid.x + 1;
+            selected_nodes[2].y = node_mid.y - 1;
+            break;
+        case RIGHT_BOTTOM:
+        case BOTTOM_RIGHT:
+            selected_nodes[2].x = node_mid.x + 1;
+            selected_nodes[2].y = node_mid.y + 1;
+            break;
+        case LEFT_BOTTOM:
+        case BOTTOM_LEFT:
+            selected_nodes[2].x = node_mid.x - 1;
+            selected_nodes[2].y = node_mid.y + 1;
+            break;
+        default:
+            break;
+        }
+
+        return 3;
+    case LETTER_S:
+        // Rows from top to bottom, each from left to right
+        for (int i = 0; i < 9; i++)
+        {
+            selected_nodes[i].x = node_mid.x + (i % 3) - 1;
+            selected_nodes[i].y = node_mid.y + (i / 3) - 1;
+        }
+
+        return 9;
+    default:
+        printf("ERROR: Wrong direction code %d.", direction);
+        exit(1);
+    }
+}
+
+static void set_direction_passages(struct maze_walls *walls, struct coordinate *selected_nodes, int direction,
+                                   void (*set_passage)(struct maze_walls *, struct coordinate, struct coordinate))
+{
+    if (direction == LETTER_S)
     {
-        maze_draft[i] = (int *)calloc(size, sizeof(int));
+        // Three horizontal lines
+        set_passage(walls, selected_nodes[0], selected_nodes[1]);
+        set_passage(walls, selected_nodes[1], selected_nodes[2]);
+        set_passage(walls, selected_nodes[3], selected_nodes[4]);
+        set_passage(walls, selected_nodes[4], selected_nodes[5]);
+        set_passage(walls, selected_nodes[6], selected_nodes[7]);
+        set_passage(walls, selected_nodes[7], selected_nodes[8]);
+
+        // First and third vertical lines
+        set_passage(walls, selected_nodes[0], selected_nodes[3]);
+        set_passage(walls, selected_nodes[5], selected_nodes[8]);
     }
+    else
+    {
+        // Standard directions link 0-1, diagonal ones also 1-2
+        set_passage(walls, selected_nodes[0], selected_nodes[1]);
 
-    // Assign each cell in draft an integer identifier
-    for (int x = 0; x < size; x++)
+        if (direction != TOP && direction != RIGHT && direction != BOTTOM && direction != LEFT)
+            set_passage(walls, selected_nodes[1], selected_nodes[2]);
+    }
+}
+
+void link_direction_nodes(struct maze_walls *walls, struct coordinate *selected_nodes, int direction)
+{
+    set_direction_passages(walls, selected_nodes, direction, maze_walls_link);
+}
+
+void unlink_direction_nodes(struct maze_walls *walls, struct coordinate *selected_nodes, int direction)
+{
+    set_direction_passages(walls, selected_nodes, direction, maze_walls_unlink);
+}
+
+int find_room(int *rooms, int node)
+{
+    // Path halving
+    while (rooms[node] != node)
     {
-        for (int y = 0; y < size; y++)
+        rooms[node] = rooms[rooms[node]];
+        node = rooms[node];
+    }
+    return node;
+}
+
+void room_window(int window[3][3], int *rooms, const struct maze_walls *walls, struct coordinate node_mid)
+{
+    // Cells outside the grid are never read by legal_directions
+    int size = walls->size;
+
+    for (int dx = -1; dx <= 1; dx++)
+    {
+        for (int dy = -1; dy <= 1; dy++)
         {
-            maze_draft[x][y] = x * size + y;
+            int x = node_mid.x + dx;
+            int y = node_mid.y + dy;
+            bool inside = x >= 0 && x < size && y >= 0 && y < size;
+            window[dx + 1][dy + 1] = inside ? find_room(rooms, maze_cell_index(walls, x, y)) : -1;
         }
     }
+}
 
-    // Print maze_draft
-    if (verbose)
+void count_degrees(struct maze *result, const struct maze_walls *walls)
+{
+    int size = walls->size;
+
+    result->total_deg1_nodes = 0;
+    result->total_deg2_nodes = 0;
+    result->total_deg3_nodes = 0;
+    result->total_deg4_nodes = 0;
+
+    for (int i = 0; i < walls->total_cells; i++)
     {
-        print_maze_draft(maze_draft, size);
-        printf("\n");
+        // Morton padding cells are never linked
+        if (walls->layout == MAZE_LAYOUT_MORTON)
+        {
+            struct coordinate cell = maze_cell_coordinate(walls, i);
+            if ((int)cell.x >= size || (int)cell.y >= size)
+                continue;
+        }
+
+        switch (maze_walls_degree(walls, i))
+        {
+        case 1:
+            result->total_deg1_nodes++;
+            break;
+        case 2:
+            result->total_deg2_nodes++;
+            break;
+        case 3:
+            result->total_deg3_nodes++;
+            break;
+        case 4:
+            result->total_deg4_nodes++;
+            break;
+        default:
+            printf("ERROR: Bad degree.");
+            exit(1);
+        }
     }
+}
+
+static void print_rooms(int *rooms, const struct maze_walls *walls)
+{
+    int size = walls->size;
 
-    // Create graph
-    int **graph = (int **)calloc(total_nodes, sizeof(int *));
-    for (int i = 0; i < total_nodes; i++)
+    int **maze_draft = (int **)calloc(size, sizeof(int *));
+    for (int x = 0; x < size; x++)
     {
-        graph[i] = (int *)calloc(total_nodes, sizeof(int));
+        maze_draft[x] = (int *)calloc(size, sizeof(int));
+        for (int y = 0; y < size; y++)
+            maze_draft[x][y] = find_room(rooms, maze_cell_index(walls, x, y));
+    }
+
+    print_maze_draft(maze_draft, size);
+
+    for (int x = 0; x < size; x++)
+        free(maze_draft[x]);
+    free(maze_draft);
+}
+
+static struct maze generate_walls(bool verbose, struct maze_walls *walls, unsigned int direction_options, struct rng *rng,
+                                  struct event_log *log, struct generation_watch *watch)
+{
+    if (direction_options & UNIFORM_SAMPLING)
+        return uniform_kruskal_walls(verbose, walls, direction_options, rng, log, watch);
+
+    // Same mazes, seed for seed; verbose runs keep the draft printing below
+    if (!verbose && walls->size <= BITBOARD_MAX_SIZE)
+        return bitboard_kruskal_walls(walls, direction_options, rng, log, watch);
+
+    struct maze result;
+
+    const int size = walls->size;
+    const int total_nodes = size * size;
+
+    // Rooms are a disjoint-set forest over cells, stored in the same layout
+    // as the walls. Merging only relinks the room roots, instead of
+    // relabelling every cell in the maze draft.
+    int *rooms = (int *)maze_allocate(walls->allocator, (size_t)walls->total_cells * sizeof(int));
+    if (rooms == NULL)
+    {
+        printf("ERROR: Can't allocate rooms for size %d.\n", size);
+        exit(1);
+    }
+
+    for (int i = 0; i < walls->total_cells; i++)
+    {
+        rooms[i] = i;
+    }
+
+    // Print maze_draft
+    if (verbose)
+    {
+        print_rooms(rooms, walls);
+        printf("\n");
     }
 
     int pass_number = 0;
     int failed_pass_number = 0;
     int rooms_counter = total_nodes;
     int fail_streak = 0;
-    const int max_fail_streak = size * size * 10;
+    const long long max_fail_streak = (long long)size * size * 10;
+    bool stopped = false;
+
+    // Each bulk letter-S counts as one pass, as if the loop had hit it
+    if ((direction_options & LETTER_PREPASS) && (direction_options & ENABLE_LETTERS))
+    {
+        int total_centers;
+        struct coordinate *centers = letter_prepass(size, rng, &total_centers);
+
+        for (int i = 0; i < total_centers; i++)
+        {
+            pass_number++;
+
+            struct coordinate selected_nodes[9];
+            direction_nodes(selected_nodes, centers[i], LETTER_S);
+            link_direction_nodes(walls, selected_nodes, LETTER_S);
+
+            if (log)
+                event_log_append(log, centers[i].x * size + centers[i].y, pass_number, LETTER_S);
+
+            // Nine fresh rooms
+            int target_room = maze_cell_index(walls, selected_nodes[0].x, selected_nodes[0].y);
+            for (int j = 1; j < 9; j++)
+                rooms[maze_cell_index(walls, selected_nodes[j].x, selected_nodes[j].y)] = target_room;
+            rooms_counter -= 8;
+
+            if (watch && !watch->merged(watch->context, centers[i].x * size + centers[i].y, pass_number, LETTER_S))
+            {
+                stopped = true;
+                break;
+            }
+        }
+
+        free(centers);
+
+        if (verbose)
+        {
+            printf("Letter-S pre-pass: %d placed\n", total_centers);
+            print_rooms(rooms, walls);
+            printf("\n");
+        }
+    }
 
-    while (1)
+    while (rooms_counter > 1 && !stopped)
     {
         pass_number++;
 
         struct coordinate node_mid;
 
-        node_mid.x = rand() % size;
-        node_mid.y = rand() % size;
+        node_mid.x = rng_range(rng, size);
+        node_mid.y = rng_range(rng, size);
+
+        int window[3][3];
+        room_window(window, rooms, walls, node_mid);
 
-        unsigned char *directions = available_directions(node_mid.x, node_mid.y, maze_draft, size, direction_options);
-        unsigned char total_available_directions = directions[0];
+        unsigned char directions[TOTAL_DIRECTIONS + 1];
+        unsigned char total_available_directions = legal_directions(directions, node_mid.x, node_mid.y, size, direction_options, window);
 
         // If the selected node has no available direction, re-random
         if (total_available_directions == 0)
         {
-            free(directions);
             failed_pass_number++;
             fail_streak++;
-            
+
             if (fail_streak > max_fail_streak) {
                 printf("ERROR: Too much fail streak. Can't combine all rooms using legal directions.\n");
-                print_maze(graph, size);
+                fprint_maze_walls(stdout, walls);
                 exit(1);
             }
 
@@ -279,7 +583,7 @@ struct maze randomized_kruskal(bool verbose, int size, unsigned int direction_op
         if (directions[total_available_directions] == LETTER_S) {
             // Select letter S if it's available
             selected_direction = directions[total_available_directions];
-            
+
             if (verbose)
             {
                 printf("Selected direction is letter-S because why not.");
@@ -287,7 +591,7 @@ struct maze randomized_kruskal(bool verbose, int size, unsigned int direction_op
             }
         } else {
             // Otherwise, randomize
-            int selected_index = (rand() % total_available_directions) + 1;
+            int selected_index = rng_range(rng, total_available_directions) + 1;
             selected_direction = directions[selected_index];
 
             if (verbose)
@@ -297,257 +601,40 @@ struct maze randomized_kruskal(bool verbose, int size, unsigned int direction_op
                 printf("\n");
             }
         }
- 
-        free(directions);
-
-        // direction flag
-        bool is_diagonal = false;
-        bool is_standard = false;
-        bool is_letter = false;
-
-        switch (selected_direction) {
-            case TOP:
-            case RIGHT:
-            case BOTTOM:
-            case LEFT:
-                is_standard = true;
-                break;
-            case TOP_LEFT:
-            case TOP_RIGHT:
-            case RIGHT_TOP:
-            case RIGHT_BOTTOM:
-            case BOTTOM_RIGHT:
-            case BOTTOM_LEFT:
-            case LEFT_BOTTOM:
-            case LEFT_TOP:
-                is_diagonal = true;
-                break;
-            case LETTER_S:
-                is_letter = true;
-                break;
-            default:
-                printf("ERROR: Wrong direction code %d.", selected_direction);
-                exit(1);
-        }
 
-        // get selected node coordinates
-        struct coordinate * selected_nodes;
-        int total_selected_nodes = -1;
-        
-        if (is_standard) {
-            total_selected_nodes = 2;
-            
-            selected_nodes = (struct coordinate *) calloc(total_selected_nodes, sizeof(struct coordinate));
-            selected_nodes[0] = node_mid;
+        // Get selected node coordinates and add links in the maze
+        struct coordinate selected_nodes[9];
+        int total_selected_nodes = direction_nodes(selected_nodes, node_mid, selected_direction);
 
-            switch (selected_direction)
-            {
-            case TOP:
-                selected_nodes[1].x = node_mid.x;
-                selected_nodes[1].y = node_mid.y - 1;
-                break;
-            case RIGHT:
-                selected_nodes[1].x = node_mid.x + 1;
-                selected_nodes[1].y = node_mid.y;
-                break;
-            case BOTTOM:
-                selected_nodes[1].x = node_mid.x;
-                selected_nodes[1].y = node_mid.y + 1;
-                break;
-            case LEFT:
-                selected_nodes[1].x = node_mid.x - 1;
-                selected_nodes[1].y = node_mid.y;
-                break;
-            default:
-                break;
-            }
-        } else if (is_diagonal) {
-            total_selected_nodes = 3;
+        link_direction_nodes(walls, selected_nodes, selected_direction);
 
-            selected_nodes = (struct coordinate *) calloc(total_selected_nodes, sizeof(struct coordinate));
-            selected_nodes[0] = node_mid;
-
-            switch (selected_direction)
-            {
-            case TOP_LEFT:
-            case TOP_RIGHT:
-                selected_nodes[1].x = node_mid.x;
-                selected_nodes[1].y = node_mid.y - 1;
-                break;
-            case RIGHT_TOP:
-            case RIGHT_BOTTOM:
-                selected_nodes[1].x = node_mid.x + 1;
-                selected_nodes[1].y = node_mid.y;
-                break;
-            case BOTTOM_LEFT:
-            case BOTTOM_RIGHT:
-                selected_nodes[1].x = node_mid.x;
-                selected_nodes[1].y = node_mid.y + 1;
-                break;
-            case LEFT_TOP:
-            case LEFT_BOTTOM:
-                selected_nodes[1].x = node_mid.x - 1;
-                selected_nodes[1].y = node_mid.y;
-                break;
-            default:
-                break;
-            }
-
-            switch (selected_direction)
-            {
-            case TOP_LEFT:
-            case LEFT_TOP:
-                selected_nodes[2].x = node_mid.x - 1;
-                selected_nodes[2].y = node_mid.y - 1;
-                break;
-            case TOP_RIGHT:
-            case RIGHT_TOP:
-                selected_nodes[2].x = node_mid.x + 1;
-                selected_nodes[2].y = node_mid.y - 1;
-                break;
-            case RIGHT_BOTTOM:
-            case BOTTOM_RIGHT:
-                selected_nodes[2].x = node_mid.x + 1;
-                selected_nodes[2].y = node_mid.y + 1;
-                break;
-            case LEFT_BOTTOM:
-            case BOTTOM_LEFT:
-                selected_nodes[2].x = node_mid.x - 1;
-                selected_nodes[2].y = node_mid.y + 1;
-                break;
-            default:
-                break;
-            }
-
-        } else if (is_letter && selected_direction == LETTER_S) {
-            total_selected_nodes = 9;
-
-            selected_nodes = (struct coordinate *) calloc(total_selected_nodes, sizeof(struct coordinate));
-            
-            // First row
-            selected_nodes[0].x = node_mid.x - 1;
-            selected_nodes[0].y = node_mid.y - 1;
-            selected_nodes[1].x = node_mid.x;
-            selected_nodes[1].y = node_mid.y - 1;
-            selected_nodes[2].x = node_mid.x + 1;
-            selected_nodes[2].y = node_mid.y - 1;
-            
-            // Second row
-            selected_nodes[3].x = node_mid.x - 1;
-            selected_nodes[3].y = node_mid.y;
-            selected_nodes[4].x = node_mid.x;
-            selected_nodes[4].y = node_mid.y;
-            selected_nodes[5].x = node_mid.x + 1;
-            selected_nodes[5].y = node_mid.y;
-            
-            // Last row
-            selected_nodes[6].x = node_mid.x - 1;
-            selected_nodes[6].y = node_mid.y + 1;
-            selected_nodes[7].x = node_mid.x;
-            selected_nodes[7].y = node_mid.y + 1;
-            selected_nodes[8].x = node_mid.x + 1;
-            selected_nodes[8].y = node_mid.y + 1;
-
-        } else {
-            printf("FAIL: wrong mode.");
-            exit(1);
-        }
-                
-        // Add link in the graph
-        
-        if (is_standard) {
-            int node0_id = selected_nodes[0].x * size + selected_nodes[0].y;
-            int node1_id = selected_nodes[1].x * size + selected_nodes[1].y;
-
-            graph[node0_id][node1_id] = 1;
-            graph[node1_id][node0_id] = 1;
-        } else if (is_diagonal) {
-            int node0_id = selected_nodes[0].x * size + selected_nodes[0].y;
-            int node1_id = selected_nodes[1].x * size + selected_nodes[1].y;
-            int node2_id = selected_nodes[2].x * size + selected_nodes[2].y;
-
-            graph[node0_id][node1_id] = 1;
-            graph[node1_id][node0_id] = 1;
-
-            graph[node1_id][node2_id] = 1;
-            graph[node2_id][node1_id] = 1;
-        } else if (is_letter && selected_direction == LETTER_S) {
-            
-            int node_id[9];
-            
-            for (int i = 0; i < 9; i++) {
-                node_id[i] = selected_nodes[i].x * size + selected_nodes[i].y;
-            }
-            
-            // First horizontal line
-            graph[node_id[0]][node_id[1]] = 1;
-            graph[node_id[1]][node_id[0]] = 1;
-            graph[node_id[1]][node_id[2]] = 1;
-            graph[node_id[2]][node_id[1]] = 1;
-            
-            // Second horizontal line
-            graph[node_id[3]][node_id[4]] = 1;
-            graph[node_id[4]][node_id[3]] = 1;
-            graph[node_id[4]][node_id[5]] = 1;
-            graph[node_id[5]][node_id[4]] = 1;
-            
-            // Third horizontal line
-            graph[node_id[6]][node_id[7]] = 1;
-            graph[node_id[7]][node_id[6]] = 1;
-            graph[node_id[7]][node_id[8]] = 1;
-            graph[node_id[8]][node_id[7]] = 1;
-
-            // First Vertical Line
-            graph[node_id[0]][node_id[3]] = 1;
-            graph[node_id[3]][node_id[0]] = 1;
-
-            // Third Vertical Line
-            graph[node_id[5]][node_id[8]] = 1;
-            graph[node_id[8]][node_id[5]] = 1;
-        }
+        if (log)
+            event_log_append(log, node_mid.x * size + node_mid.y, pass_number, selected_direction);
 
         // Unify rooms in maze draft
-        bool * merge_room_hashes = (bool *) calloc(total_nodes, sizeof(bool));
-        
-        for (int i = 0; i < total_selected_nodes; i++) {
-            int room_id = maze_draft[selected_nodes[i].x][selected_nodes[i].y];
-            merge_room_hashes[room_id] = true;
-        }
+        int target_room = find_room(rooms, maze_cell_index(walls, selected_nodes[0].x, selected_nodes[0].y));
 
-        int target_room = maze_draft[selected_nodes[0].x][selected_nodes[0].y];
- 
-        for (int x = 0; x < size; x++)
-        {
-            for (int y = 0; y < size; y++)
-            {
-                if (merge_room_hashes[maze_draft[x][y]]) maze_draft[x][y] = target_room;
-            }
+        for (int i = 1; i < total_selected_nodes; i++) {
+            int room_id = find_room(rooms, maze_cell_index(walls, selected_nodes[i].x, selected_nodes[i].y));
+            rooms[room_id] = target_room;
         }
 
         // Print maze_draft
         if (verbose)
-            print_maze_draft(maze_draft, size);
+            print_rooms(rooms, walls);
 
-        // Recalculate the total rooms
-        if (is_standard)
-        {
-            rooms_counter -= 1;
-        }
-        else if (is_diagonal)
-        {
-            rooms_counter -= 2;
-        }
-        else if (is_letter && selected_direction == LETTER_S)
+        // Every selected node was in its own room
+        rooms_counter -= total_selected_nodes - 1;
+
+        if (watch && !watch->merged(watch->context, node_mid.x * size + node_mid.y, pass_number, selected_direction))
         {
-            rooms_counter -= 8;
+            stopped = true;
+            break;
         }
 
         if (verbose)
             printf("Total rooms: %d\n", rooms_counter);
 
-        free(selected_nodes);
-        free(merge_room_hashes);
-
         // All done!!!
         if (rooms_counter == 1) {
             break;
@@ -556,44 +643,78 @@ struct maze randomized_kruskal(bool verbose, int size, unsigned int direction_op
         }
     }
 
-    result.total_deg1_nodes = 0;
-    result.total_deg2_nodes = 0;
-    result.total_deg3_nodes = 0;
-    result.total_deg4_nodes = 0;
+    // An unfinished maze has cells without passages
+    if (stopped)
+        result.total_deg1_nodes = result.total_deg2_nodes = result.total_deg3_nodes = result.total_deg4_nodes = 0;
+    else
+        count_degrees(&result, walls);
 
-    // Print all connections
-    for (int i = 0; i < total_nodes; i++)
+    if (verbose)
     {
-        int current_degree = 0;
-        for (int j = 0; j < total_nodes; j++)
-        {
-            if (graph[i][j] == 1)
-                current_degree++;
-        }
+        printf("DONE!\n\n");
 
-        switch (current_degree)
+        // Print all connections
+        printf("All connections:\n");
+        for (int i = 0; i < total_nodes; i++)
         {
-        case 1:
-            result.total_deg1_nodes++;
-            break;
-        case 2:
-            result.total_deg2_nodes++;
-            break;
-        case 3:
-            result.total_deg3_nodes++;
-            break;
-        case 4:
-            result.total_deg4_nodes++;
-            break;
-        default:
-            printf("ERROR: Bad degree.");
-            exit(1);
+            unsigned char passages = walls->cells[maze_cell_index(walls, i / size, i % size)];
+
+            printf("Node [%d] -> ", i);
+            if (passages & PASSAGE_LEFT)
+                printf("[%d]", i - size);
+            if (passages & PASSAGE_TOP)
+                printf("[%d]", i - 1);
+            if (passages & PASSAGE_BOTTOM)
+                printf("[%d]", i + 1);
+            if (passages & PASSAGE_RIGHT)
+                printf("[%d]", i + size);
+            printf("\n");
         }
+        printf("\n");
+
+        // Print total passes
+        printf("Total passes: %d\n", pass_number);
+        printf("Total failed passes: %d\n", failed_pass_number);
+
+        printf("\n");
     }
 
+    // Free mems
+    maze_release(walls->allocator, rooms, (size_t)walls->total_cells * sizeof(int));
+
+    result.total_passes = pass_number;
+    result.total_failed_passes = failed_pass_number;
+    result.size = size;
+    result.graph = NULL;
+    result.total_nodes = total_nodes;
+
+    return result;
+}
+
+struct maze randomized_kruskal_walls(bool verbose, struct maze_walls *walls, unsigned int direction_options, struct rng *rng, struct event_log *log)
+{
+    return generate_walls(verbose, walls, direction_options, rng, log, NULL);
+}
+
+struct maze randomized_kruskal_watched(struct maze_walls *walls, unsigned int direction_options, struct rng *rng, struct generation_watch *watch)
+{
+    return generate_walls(false, walls, direction_options, rng, NULL, watch);
+}
+
+struct maze randomized_kruskal(bool verbose, int size, unsigned int direction_options)
+{
+    // Keep srand() in control of the result
+    struct rng rng;
+    rng_seed(&rng, ((unsigned long long)rand() << 32) ^ (unsigned long long)rand());
+
+    struct maze_walls *walls = maze_walls_create(size);
+    struct maze result = randomized_kruskal_walls(verbose, walls, direction_options, &rng, NULL);
+
+    result.graph = maze_walls_to_graph(walls);
+
     if (verbose)
     {
-        printf("DONE!\n\n");
+        const int total_nodes = size * size;
 
         // Print graph
         printf("Final graph:\n");
@@ -610,46 +731,14 @@ struct maze randomized_kruskal(bool verbose, int size, unsigned int direction_op
 
             for (int y = 0; y < total_nodes; y++)
             {
-                printf("%d\t", graph[x][y]);
+                printf("%d\t", result.graph[x][y]);
             }
             printf("\n");
         }
         printf("\n");
-
-        // Print all connections
-        printf("All connections:\n");
-        for (int i = 0; i < total_nodes; i++)
-        {
-            printf("Node [%d] -> ", i);
-
-            for (int j = 0; j < total_nodes; j++)
-            {
-                if (graph[i][j] == 1)
-                {
-                    printf("[%d]", j);
-                }
-            }
-            printf("\n");
-        }
-        printf("\n");
-
-        // Print total passes
-        printf("Total passes: %d\n", pass_number);
-        printf("Total failed passes: %d\n", failed_pass_number);
-
-        printf("\n");
     }
 
-    // Free mems
-    for (int i = 0; i < size; i++)
-        free(maze_draft[i]);
-    free(maze_draft);
-
-    result.total_passes = pass_number;
-    result.total_failed_passes = failed_pass_number;
-    result.size = size;
-    result.graph = graph;
-    result.total_nodes = total_nodes;
+    maze_walls_free(walls);
 
     return result;
 }
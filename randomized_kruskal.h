@@ -13,11 +13,29 @@
 #include <stdlib.h>
 
 #include "definitions.h"
+#include "event_log.h"
+#include "generation_watch.h"
+#include "maze_walls.h"
+#include "rng.h"
 #include "util.h"
 #include "print_maze_draft.h"
 #include "print_maze.h"
+#include "uniform_kruskal.h"
+#include "bitboard_kruskal.h"
+#include "letter_prepass.h"
 
+extern int legal_directions(unsigned char *directions, int x, int y, int size, unsigned int options, int rooms[3][3]);
 extern unsigned char *available_directions(int x, int y, int **maze_draft, int size, unsigned int options);
+extern int direction_nodes(struct coordinate *selected_nodes, struct coordinate node_mid, int direction);
+extern void link_direction_nodes(struct maze_walls *walls, struct coordinate *selected_nodes, int direction);
+extern void unlink_direction_nodes(struct maze_walls *walls, struct coordinate *selected_nodes, int direction);
+extern int find_room(int *rooms, int node);
+extern void room_window(int window[3][3], int *rooms, const struct maze_walls *walls, struct coordinate node_mid);
+extern void count_degrees(struct maze *result, const struct maze_walls *walls);
+extern struct maze randomized_kruskal_walls(bool verbose, struct maze_walls *walls, unsigned int direction_options, struct rng *rng, struct event_log *log);
+// Same maze as randomized_kruskal_walls() for the same rng, unless watch
+// stops it early
+extern struct maze randomized_kruskal_watched(struct maze_walls *walls, unsigned int direction_options, struct rng *rng, struct generation_watch *watch);
 extern struct maze randomized_kruskal(bool verbose, int size, unsigned int direction_options);
 
 #endif /* randomized_kruskal_h */
@@ -0,0 +1,67 @@
+//
+//  recursive_backtracker.c
+//  kruskal-maze-generation-c
+//
+//  Created by Ezzat Chamudi on 10/19/26.
+//  Copyright © 2026 Ezzat Chamudi. All rights reserved.
+//  License: Apache-2.0
+//
+
+#include "recursive_backtracker.h"
+
+// Recursive backtracker (randomized depth-first search) with an explicit
+// stack: walk to a random unvisited neighbour, back up when there is none.
+//
+// Cost: O(n). Each cell is pushed and popped once, and every step picks from
+// at most four neighbours. Memory is one byte per cell for visited flags plus
+// a stack that can grow to n ints on long corridors. Mazes have long winding
+// passages and few dead ends. Standard directions only.
+
+static const int step_dx[4] = {0, 1, 0, -1};
+static const int step_dy[4] = {-1, 0, 1, 0};
+
+void recursive_backtracker_walls(struct maze_walls *walls, struct rng *rng)
+{
+    const int size = walls->size;
+    const int total_nodes = size * size;
+
+    unsigned char *visited = (unsigned char *)calloc(total_nodes, sizeof(unsigned char));
+    int *stack = (int *)malloc((size_t)total_nodes * sizeof(int));
+    int depth = 0;
+
+    int start = rng_range(rng, total_nodes);
+    visited[start] = 1;
+    stack[depth++] = start;
+
+    while (depth > 0)
+    {
+        int node = stack[depth - 1];
+        struct coordinate current = {node / size, node % size};
+
+        int candidates[4];
+        int total_candidates = 0;
+        for (int side = 0; side < 4; side++)
+        {
+            int x = current.x + step_dx[side];
+            int y = current.y + step_dy[side];
+            if (x >= 0 && x < size && y >= 0 && y < size && !visited[x * size + y])
+                candidates[total_candidates++] = x * size + y;
+        }
+
+        if (total_candidates == 0)
+        {
+            depth--;
+            continue;
+        }
+
+        int next = candidates[rng_range(rng, total_candidates)];
+        struct coordinate neighbour = {next / size, next % size};
+        maze_walls_link(walls, current, neighbour);
+
+        visited[next] = 1;
+        stack[depth++] = next;
+    }
+
+    free(visited);
+    free(stack);
+}
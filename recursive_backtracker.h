@@ -0,0 +1,21 @@
+//
+//  recursive_backtracker.h
+//  kruskal-maze-generation-c
+//
+//  Created by Ezzat Chamudi on 10/19/26.
+//  Copyright © 2026 Ezzat Chamudi. All rights reserved.
+//  License: Apache-2.0
+//
+
+#ifndef recursive_backtracker_h
+#define recursive_backtracker_h
+
+#include <stdlib.h>
+
+#include "definitions.h"
+#include "maze_walls.h"
+#include "rng.h"
+
+extern void recursive_backtracker_walls(struct maze_walls *walls, struct rng *rng);
+
+#endif /* recursive_backtracker_h */
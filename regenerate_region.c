@@ -0,0 +1,293 @@
+//
+//  regenerate_region.c
+//  kruskal-maze-generation-c
+//
+//  Created by Ezzat Chamudi on 10/19/26.
+//  Copyright © 2026 Ezzat Chamudi. All rights reserved.
+//  License: Apache-2.0
+//
+
+#include "regenerate_region.h"
+
+#include "randomized_kruskal.h"
+
+// Re-randomizes the passages inside a region of a perfect maze and keeps it
+// perfect, touching only the region's cells.
+//
+// Passages crossing the region border stay as they are. Which of them are
+// joined outside the region can't be known without walking the rest of the
+// maze, so the region must join them inside exactly as before: the old
+// passages form a forest inside the region, and of each tree only the paths
+// between its border openings (its spine) are kept. Everything else is
+// cleared and regenerated with the usual selection, where a move is only
+// legal if it joins at most one spine. Every free cell can always reach a
+// spine with a standard move, so generation can't get stuck.
+
+static const int side_dx[4] = {0, 1, 0, -1};
+static const int side_dy[4] = {-1, 0, 1, 0};
+static const unsigned char side_passage[4] = {PASSAGE_TOP, PASSAGE_RIGHT, PASSAGE_BOTTOM, PASSAGE_LEFT};
+
+static bool inside_region(struct maze_region region, int x, int y)
+{
+    return x >= region.x0 && x < region.x0 + region.width && y >= region.y0 && y < region.y0 + region.height;
+}
+
+static int region_index(struct maze_region region, int x, int y)
+{
+    return (x - region.x0) * region.height + (y - region.y0);
+}
+
+// Local index of the neighbour through an open passage inside the region, or -1
+static int region_neighbour(const struct maze_walls *walls, struct maze_region region, int x, int y, int side)
+{
+    if (!(walls->cells[maze_cell_index(walls, x, y)] & side_passage[side]))
+        return -1;
+
+    int nx = x + side_dx[side];
+    int ny = y + side_dy[side];
+    return inside_region(region, nx, ny) ? region_index(region, nx, ny) : -1;
+}
+
+int regenerate_region(struct maze_walls *walls, struct maze_region region, unsigned int direction_options, struct rng *rng)
+{
+    const int size = walls->size;
+
+    if (region.width < 1 || region.height < 1 || region.x0 < 0 || region.y0 < 0
+        || region.x0 + region.width > size || region.y0 + region.height > size)
+    {
+        printf("ERROR: Region %dx%d at (%d, %d) is outside the maze of size %d.\n",
+               region.width, region.height, region.x0, region.y0, size);
+        exit(1);
+    }
+
+    const int total_cells = region.width * region.height;
+
+    int *components = (int *)calloc(total_cells, sizeof(int));
+    int *rooms = (int *)calloc(total_cells, sizeof(int));
+    int *tags = (int *)calloc(total_cells, sizeof(int));
+    int *queue = (int *)calloc(total_cells, sizeof(int));
+    unsigned char *degrees = (unsigned char *)calloc(total_cells, sizeof(unsigned char));
+    bool *anchors = (bool *)calloc(total_cells, sizeof(bool));
+    bool *spine = (bool *)calloc(total_cells, sizeof(bool));
+
+    // Old trees inside the region, their border openings and inner degrees
+    for (int i = 0; i < total_cells; i++)
+        components[i] = -1;
+
+    for (int start = 0; start < total_cells; start++)
+    {
+        if (components[start] >= 0)
+            continue;
+
+        int head = 0, tail = 0;
+        queue[tail++] = start;
+        components[start] = start;
+
+        while (head < tail)
+        {
+            int cell = queue[head++];
+            int x = region.x0 + cell / region.height;
+            int y = region.y0 + cell % region.height;
+
+            for (int side = 0; side < 4; side++)
+            {
+                if (!(walls->cells[maze_cell_index(walls, x, y)] & side_passage[side]))
+                    continue;
+
+                int neighbour = region_neighbour(walls, region, x, y, side);
+                if (neighbour < 0)
+                {
+                    anchors[cell] = true;
+                    continue;
+                }
+
+                degrees[cell]++;
+                if (components[neighbour] < 0)
+                {
+                    components[neighbour] = start;
+                    queue[tail++] = neighbour;
+                }
+            }
+        }
+    }
+
+    // Prune leaves without an opening; what's left of each tree is its spine
+    int head = 0, tail = 0;
+    for (int cell = 0; cell < total_cells; cell++)
+    {
+        spine[cell] = true;
+        if (!anchors[cell] && degrees[cell] <= 1)
+            queue[tail++] = cell;
+    }
+
+    while (head < tail)
+    {
+        int cell = queue[head++];
+        int x = region.x0 + cell / region.height;
+        int y = region.y0 + cell % region.height;
+        spine[cell] = false;
+
+        for (int side = 0; side < 4; side++)
+        {
+            int neighbour = region_neighbour(walls, region, x, y, side);
+            if (neighbour < 0 || !spine[neighbour])
+                continue;
+
+            degrees[neighbour]--;
+            if (!anchors[neighbour] && degrees[neighbour] == 1)
+                queue[tail++] = neighbour;
+        }
+    }
+
+    // Clear everything off the spines; spine cells start as one room per tree
+    for (int cell = 0; cell < total_cells; cell++)
+        rooms[cell] = cell;
+
+    for (int cell = 0; cell < total_cells; cell++)
+    {
+        struct coordinate node;
+        node.x = region.x0 + cell / region.height;
+        node.y = region.y0 + cell % region.height;
+
+        // Right and bottom only, so each passage is seen once
+        for (int side = 1; side <= 2; side++)
+        {
+            int neighbour = region_neighbour(walls, region, node.x, node.y, side);
+            if (neighbour < 0)
+                continue;
+
+            if (spine[cell] && spine[neighbour])
+            {
+                rooms[find_room(rooms, neighbour)] = find_room(rooms, cell);
+            }
+            else
+            {
+                struct coordinate other;
+                other.x = node.x + side_dx[side];
+                other.y = node.y + side_dy[side];
+                maze_walls_unlink(walls, node, other);
+            }
+        }
+    }
+
+    for (int cell = 0; cell < total_cells; cell++)
+        tags[cell] = -1;
+
+    int rooms_counter = 0;
+    int target_rooms = 0;
+    for (int cell = 0; cell < total_cells; cell++)
+    {
+        if (rooms[cell] == cell)
+            rooms_counter++;
+        if (spine[cell] && tags[find_room(rooms, cell)] < 0)
+        {
+            tags[find_room(rooms, cell)] = components[cell];
+            target_rooms++;
+        }
+    }
+
+    // Only a region covering the whole maze has no openings
+    if (target_rooms == 0)
+        target_rooms = 1;
+
+    int pass_number = 0;
+    int fail_streak = 0;
+    const long long max_fail_streak = (long long)total_cells * 10;
+
+    while (rooms_counter > target_rooms)
+    {
+        pass_number++;
+
+        int cell = rng_range(rng, total_cells);
+
+        struct coordinate node_mid;
+        node_mid.x = region.x0 + cell / region.height;
+        node_mid.y = region.y0 + cell % region.height;
+
+        // Cells outside the region read as the middle room, so no move uses them
+        int mid_room = find_room(rooms, cell);
+        int window[3][3];
+        for (int dx = -1; dx <= 1; dx++)
+        {
+            for (int dy = -1; dy <= 1; dy++)
+            {
+                int x = node_mid.x + dx;
+                int y = node_mid.y + dy;
+                window[dx + 1][dy + 1] = inside_region(region, x, y) ? find_room(rooms, region_index(region, x, y)) : mid_room;
+            }
+        }
+
+        unsigned char directions[TOTAL_DIRECTIONS + 1];
+        int total_legal = legal_directions(directions, node_mid.x, node_mid.y, size, direction_options, window);
+
+        // Keep the moves that join at most one spine
+        int total_available_directions = 0;
+        for (int i = 1; i <= total_legal; i++)
+        {
+            struct coordinate selected_nodes[9];
+            int total_selected_nodes = direction_nodes(selected_nodes, node_mid, directions[i]);
+
+            int tag = -1;
+            bool allowed = true;
+            for (int j = 0; j < total_selected_nodes && allowed; j++)
+            {
+                int node_tag = tags[window[selected_nodes[j].x - node_mid.x + 1][selected_nodes[j].y - node_mid.y + 1]];
+                if (node_tag >= 0 && tag >= 0 && node_tag != tag)
+                    allowed = false;
+                if (node_tag >= 0)
+                    tag = node_tag;
+            }
+
+            if (allowed)
+                directions[++total_available_directions] = directions[i];
+        }
+
+        if (total_available_directions == 0)
+        {
+            fail_streak++;
+
+            if (fail_streak > max_fail_streak) {
+                printf("ERROR: Too much fail streak. Can't combine all rooms using legal directions.\n");
+                exit(1);
+            }
+
+            continue;
+        }
+        fail_streak = 0;
+
+        // Same selection as randomized_kruskal_walls
+        int selected_direction;
+        if (directions[total_available_directions] == LETTER_S)
+            selected_direction = LETTER_S;
+        else
+            selected_direction = directions[rng_range(rng, total_available_directions) + 1];
+
+        struct coordinate selected_nodes[9];
+        int total_selected_nodes = direction_nodes(selected_nodes, node_mid, selected_direction);
+
+        link_direction_nodes(walls, selected_nodes, selected_direction);
+
+        int target_room = find_room(rooms, region_index(region, selected_nodes[0].x, selected_nodes[0].y));
+        int tag = tags[target_room];
+
+        for (int i = 1; i < total_selected_nodes; i++) {
+            int room_id = find_room(rooms, region_index(region, selected_nodes[i].x, selected_nodes[i].y));
+            if (tags[room_id] >= 0)
+                tag = tags[room_id];
+            rooms[room_id] = target_room;
+        }
+        tags[target_room] = tag;
+
+        rooms_counter -= total_selected_nodes - 1;
+    }
+
+    free(components);
+    free(rooms);
+    free(tags);
+    free(queue);
+    free(degrees);
+    free(anchors);
+    free(spine);
+
+    return pass_number;
+}
@@ -0,0 +1,31 @@
+//
+//  regenerate_region.h
+//  kruskal-maze-generation-c
+//
+//  Created by Ezzat Chamudi on 10/19/26.
+//  Copyright © 2026 Ezzat Chamudi. All rights reserved.
+//  License: Apache-2.0
+//
+
+#ifndef regenerate_region_h
+#define regenerate_region_h
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include "definitions.h"
+#include "maze_walls.h"
+#include "rng.h"
+
+// Region of a maze, x0 <= x < x0 + width and y0 <= y < y0 + height
+struct maze_region {
+    int x0;
+    int y0;
+    int width;
+    int height;
+};
+
+extern int regenerate_region(struct maze_walls *walls, struct maze_region region, unsigned int direction_options, struct rng *rng);
+
+#endif /* regenerate_region_h */
@@ -0,0 +1,38 @@
+//
+//  rng.c
+//  kruskal-maze-generation-c
+//
+//  Created by Ezzat Chamudi on 10/19/26.
+//  Copyright © 2026 Ezzat Chamudi. All rights reserved.
+//  License: Apache-2.0
+//
+
+#include "rng.h"
+
+void rng_seed(struct rng *rng, unsigned long long seed)
+{
+    rng->state = seed;
+}
+
+unsigned long long rng_next(struct rng *rng)
+{
+    unsigned long long z = (rng->state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+unsigned int rng_range(struct rng *rng, unsigned int n)
+{
+    // Multiply-shift instead of modulo; n is always far below 2^32 here
+    return (unsigned int)(((rng_next(rng) >> 32) * (unsigned long long)n) >> 32);
+}
+
+unsigned long long rng_derive(unsigned long long seed, unsigned long long value)
+{
+    // Independent seed for a sub-task (chunk, trial, ...) of a seeded run
+    struct rng rng;
+    rng_seed(&rng, seed ^ (value * 0xD6E8FEB86659FD93ULL));
+    rng_next(&rng);
+    return rng_next(&rng);
+}
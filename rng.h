@@ -0,0 +1,24 @@
+//
+//  rng.h
+//  kruskal-maze-generation-c
+//
+//  Created by Ezzat Chamudi on 10/19/26.
+//  Copyright © 2026 Ezzat Chamudi. All rights reserved.
+//  License: Apache-2.0
+//
+
+#ifndef rng_h
+#define rng_h
+
+// Small seedable generator (SplitMix64). Each generation carries its own state,
+// so seeded mazes are reproducible and threads don't share rand().
+struct rng {
+    unsigned long long state;
+};
+
+extern void rng_seed(struct rng *rng, unsigned long long seed);
+extern unsigned long long rng_next(struct rng *rng);
+extern unsigned int rng_range(struct rng *rng, unsigned int n);
+extern unsigned long long rng_derive(unsigned long long seed, unsigned long long value);
+
+#endif /* rng_h */
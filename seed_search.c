@@ -0,0 +1,430 @@
+//
+//  seed_search.c
+//  kruskal-maze-generation-c
+//
+//  Created by Ezzat Chamudi on 10/19/26.
+//  Copyright © 2026 Ezzat Chamudi. All rights reserved.
+//  License: Apache-2.0
+//
+
+#include "seed_search.h"
+
+#include <limits.h>
+#include <pthread.h>
+#include <string.h>
+
+#include "generation_watch.h"
+#include "randomized_kruskal.h"
+#include "rng.h"
+
+const char *seed_metric_names[TOTAL_SEARCH_METRICS] = {
+    "deg1", "deg2", "deg3", "deg4", "passes", "failed", "letters", "solution", "longest"
+};
+
+void seed_predicate_init(struct seed_predicate *predicate)
+{
+    for (int i = 0; i < TOTAL_SEARCH_METRICS; i++)
+    {
+        predicate->minimums[i] = INT_MIN;
+        predicate->maximums[i] = INT_MAX;
+    }
+}
+
+bool seed_predicate_add(struct seed_predicate *predicate, const char *condition)
+{
+    int metric = -1;
+    size_t name_length = 0;
+    for (int i = 0; i < TOTAL_SEARCH_METRICS; i++)
+    {
+        size_t length = strlen(seed_metric_names[i]);
+        if (strncmp(condition, seed_metric_names[i], length) == 0 && length > name_length)
+        {
+            metric = i;
+            name_length = length;
+        }
+    }
+    if (metric < 0)
+        return false;
+
+    const char *rest = condition + name_length;
+    int low, high;
+    char end;
+
+    if (sscanf(rest, "=%d..%d%c", &low, &high, &end) == 2) {
+        // Range, keep the tighter bounds
+    } else if (sscanf(rest, ">=%d%c", &low, &end) == 1) {
+        high = INT_MAX;
+    } else if (sscanf(rest, "<=%d%c", &high, &end) == 1) {
+        low = INT_MIN;
+    } else if (sscanf(rest, ">%d%c", &low, &end) == 1 && low < INT_MAX) {
+        low++;
+        high = INT_MAX;
+    } else if (sscanf(rest, "<%d%c", &high, &end) == 1 && high > INT_MIN) {
+        high--;
+        low = INT_MIN;
+    } else if (sscanf(rest, "=%d%c", &low, &end) == 1) {
+        high = low;
+    } else {
+        return false;
+    }
+
+    if (low > predicate->minimums[metric])
+        predicate->minimums[metric] = low;
+    if (high < predicate->maximums[metric])
+        predicate->maximums[metric] = high;
+    return true;
+}
+
+static bool in_range(const struct seed_predicate *predicate, int metric, int value)
+{
+    return value >= predicate->minimums[metric] && value <= predicate->maximums[metric];
+}
+
+// Candidate state, reused across the seeds of one thread. The watch keeps
+// its own copy of the passages and rooms, since the bitboard engine only
+// writes the walls at the end.
+struct candidate {
+    int size;
+    const struct seed_predicate *predicate;
+
+    struct maze_walls *walls;
+    int *rooms;
+    int *queue;
+    int *distances;
+
+    int total_merges;
+    int total_letters;
+    int rooms_left;
+    int at_least_deg2;
+    int at_least_deg3;
+    int total_deg4;
+    int solution; // 0 until both ends share a room
+    bool abandoned;
+};
+
+// BFS over passages from cell; fills distances (in cells, from counts as 1)
+// for its room and returns the farthest cell
+static int farthest_cell(struct candidate *candidate, int from)
+{
+    const struct maze_walls *walls = candidate->walls;
+    int *queue = candidate->queue;
+    int *distances = candidate->distances;
+    int head = 0;
+    int tail = 0;
+
+    memset(distances, 0, (size_t)walls->total_cells * sizeof(int));
+    queue[tail++] = from;
+    distances[from] = 1;
+
+    while (head < tail)
+    {
+        int cell = queue[head++];
+        unsigned char passages = walls->cells[cell];
+        struct coordinate at = maze_cell_coordinate(walls, cell);
+        int neighbours[4] = {
+            (passages & PASSAGE_TOP) ? maze_cell_index(walls, at.x, at.y - 1) : -1,
+            (passages & PASSAGE_RIGHT) ? maze_cell_index(walls, at.x + 1, at.y) : -1,
+            (passages & PASSAGE_BOTTOM) ? maze_cell_index(walls, at.x, at.y + 1) : -1,
+            (passages & PASSAGE_LEFT) ? maze_cell_index(walls, at.x - 1, at.y) : -1
+        };
+
+        for (int i = 0; i < 4; i++)
+        {
+            int next = neighbours[i];
+            if (next >= 0 && distances[next] == 0)
+            {
+                distances[next] = distances[cell] + 1;
+                queue[tail++] = next;
+            }
+        }
+    }
+
+    return queue[tail - 1];
+}
+
+// Whether the partial maze can still end up matching
+static bool still_possible(const struct candidate *candidate, int pass)
+{
+    const struct seed_predicate *predicate = candidate->predicate;
+    const int total_nodes = candidate->size * candidate->size;
+
+    // Each letter-S merges 8 rooms
+    int most_letters = candidate->total_letters + (candidate->rooms_left - 1) / 8;
+
+    return pass <= predicate->maximums[SEARCH_PASSES]
+        && pass - candidate->total_merges <= predicate->maximums[SEARCH_FAILED_PASSES]
+        && candidate->total_letters <= predicate->maximums[SEARCH_LETTERS]
+        && most_letters >= predicate->minimums[SEARCH_LETTERS]
+        && candidate->total_deg4 <= predicate->maximums[SEARCH_DEG4]
+        && 2 + candidate->at_least_deg3 + candidate->total_deg4 <= predicate->maximums[SEARCH_DEG1]
+        && total_nodes - candidate->at_least_deg2 >= predicate->minimums[SEARCH_DEG1]
+        && (candidate->solution == 0 || in_range(predicate, SEARCH_SOLUTION, candidate->solution));
+}
+
+static bool candidate_merged(void *context, unsigned int cell, unsigned int pass, unsigned char direction)
+{
+    struct candidate *candidate = (struct candidate *)context;
+    struct maze_walls *walls = candidate->walls;
+    const int size = candidate->size;
+
+    struct coordinate node_mid;
+    node_mid.x = cell / size;
+    node_mid.y = cell % size;
+
+    struct coordinate selected_nodes[9];
+    int total_selected_nodes = direction_nodes(selected_nodes, node_mid, direction);
+
+    int cells[9];
+    int degrees[9];
+    for (int i = 0; i < total_selected_nodes; i++)
+    {
+        cells[i] = maze_cell_index(walls, selected_nodes[i].x, selected_nodes[i].y);
+        degrees[i] = maze_walls_degree(walls, cells[i]);
+    }
+
+    link_direction_nodes(walls, selected_nodes, direction);
+
+    int target_room = -1;
+    for (int i = 0; i < total_selected_nodes; i++)
+    {
+        int degree = maze_walls_degree(walls, cells[i]);
+        candidate->at_least_deg2 += degrees[i] < 2 && degree >= 2;
+        candidate->at_least_deg3 += degrees[i] < 3 && degree >= 3;
+        candidate->total_deg4 += degrees[i] < 4 && degree == 4;
+
+        if (i == 0)
+            target_room = find_room(candidate->rooms, cells[0]);
+        else
+            candidate->rooms[find_room(candidate->rooms, cells[i])] = target_room;
+    }
+
+    candidate->total_merges++;
+    candidate->total_letters += direction == LETTER_S;
+    candidate->rooms_left -= total_selected_nodes - 1;
+
+    if (candidate->solution == 0)
+    {
+        int start = maze_cell_index(walls, 0, 0);
+        int end = maze_cell_index(walls, size - 1, size - 1);
+
+        if (find_room(candidate->rooms, start) == find_room(candidate->rooms, end))
+        {
+            farthest_cell(candidate, start);
+            candidate->solution = candidate->distances[end];
+        }
+    }
+
+    candidate->abandoned = !still_possible(candidate, pass);
+    return !candidate->abandoned;
+}
+
+// Generates one seed into walls; true when it matches, with its metrics
+static bool try_seed(struct candidate *candidate, struct maze_walls *walls, unsigned int direction_options,
+                     unsigned long long seed, int *metrics, bool *abandoned)
+{
+    const int size = candidate->size;
+    const struct seed_predicate *predicate = candidate->predicate;
+
+    memset(walls->cells, 0, walls->total_cells);
+    memset(candidate->walls->cells, 0, candidate->walls->total_cells);
+    for (int i = 0; i < candidate->walls->total_cells; i++)
+        candidate->rooms[i] = i;
+
+    candidate->total_merges = 0;
+    candidate->total_letters = 0;
+    candidate->rooms_left = size * size;
+    candidate->at_least_deg2 = 0;
+    candidate->at_least_deg3 = 0;
+    candidate->total_deg4 = 0;
+    candidate->solution = size == 1 ? 1 : 0;
+    candidate->abandoned = false;
+
+    struct generation_watch watch;
+    watch.merged = candidate_merged;
+    watch.context = candidate;
+
+    struct rng rng;
+    rng_seed(&rng, seed);
+    struct maze maze = randomized_kruskal_watched(walls, direction_options, &rng, &watch);
+
+    *abandoned = candidate->abandoned;
+    if (*abandoned)
+        return false;
+
+    metrics[SEARCH_DEG1] = maze.total_deg1_nodes;
+    metrics[SEARCH_DEG2] = maze.total_deg2_nodes;
+    metrics[SEARCH_DEG3] = maze.total_deg3_nodes;
+    metrics[SEARCH_DEG4] = maze.total_deg4_nodes;
+    metrics[SEARCH_PASSES] = maze.total_passes;
+    metrics[SEARCH_FAILED_PASSES] = maze.total_failed_passes;
+    metrics[SEARCH_LETTERS] = candidate->total_letters;
+    metrics[SEARCH_SOLUTION] = candidate->solution;
+
+    for (int i = 0; i < SEARCH_LONGEST; i++)
+    {
+        if (!in_range(predicate, i, metrics[i]))
+            return false;
+    }
+
+    // Longest path: farthest cell from anywhere, then farthest from that
+    int far_cell = farthest_cell(candidate, farthest_cell(candidate, 0));
+    metrics[SEARCH_LONGEST] = candidate->distances[far_cell];
+
+    return in_range(predicate, SEARCH_LONGEST, metrics[SEARCH_LONGEST]);
+}
+
+struct search_state {
+    pthread_mutex_t lock;
+
+    int size;
+    unsigned int direction_options;
+    const struct seed_predicate *predicate;
+    unsigned long long first_seed;
+    long long total_seeds;
+    int wanted;
+
+    // Seeds are claimed in order; nothing at or past the cutoff can make the
+    // first wanted matches
+    long long next_offset;
+    long long cutoff;
+
+    struct seed_match *matches; // Lowest seeds first
+    int total_matches;
+    struct seed_search_totals totals;
+};
+
+// Keeps the wanted lowest seeds
+static void add_match(struct search_state *state, const struct seed_match *match)
+{
+    int position = state->total_matches;
+    while (position > 0 && state->matches[position - 1].seed - state->first_seed > match->seed - state->first_seed)
+        position--;
+
+    if (position >= state->wanted)
+        return;
+
+    int total_moved = (state->total_matches < state->wanted ? state->total_matches : state->wanted - 1) - position;
+    memmove(&state->matches[position + 1], &state->matches[position], total_moved * sizeof(struct seed_match));
+    state->matches[position] = *match;
+
+    if (state->total_matches < state->wanted)
+        state->total_matches++;
+    if (state->total_matches == state->wanted)
+        state->cutoff = (long long)(state->matches[state->wanted - 1].seed - state->first_seed) + 1;
+}
+
+static void *search_thread(void *argument)
+{
+    struct search_state *state = (struct search_state *)argument;
+    const int size = state->size;
+
+    struct candidate candidate;
+    candidate.size = size;
+    candidate.predicate = state->predicate;
+    candidate.walls = maze_walls_create(size);
+    candidate.rooms = (int *)malloc(candidate.walls->total_cells * sizeof(int));
+    candidate.queue = (int *)malloc(candidate.walls->total_cells * sizeof(int));
+    candidate.distances = (int *)malloc(candidate.walls->total_cells * sizeof(int));
+
+    struct maze_walls *walls = maze_walls_create(size);
+    struct seed_match found[SEED_SEARCH_CHUNK];
+
+    while (1)
+    {
+        pthread_mutex_lock(&state->lock);
+        long long limit = state->cutoff < state->total_seeds ? state->cutoff : state->total_seeds;
+        long long first_offset = state->next_offset;
+        long long total_chunk = limit - first_offset < SEED_SEARCH_CHUNK ? limit - first_offset : SEED_SEARCH_CHUNK;
+        if (total_chunk > 0)
+            state->next_offset += total_chunk;
+        pthread_mutex_unlock(&state->lock);
+
+        if (total_chunk <= 0)
+            break;
+
+        int total_found = 0;
+        long long total_abandoned = 0;
+
+        for (long long i = 0; i < total_chunk; i++)
+        {
+            bool abandoned;
+            struct seed_match *match = &found[total_found];
+            match->seed = state->first_seed + (unsigned long long)(first_offset + i);
+
+            if (try_seed(&candidate, walls, state->direction_options, match->seed, match->metrics, &abandoned))
+                total_found++;
+            total_abandoned += abandoned;
+        }
+
+        pthread_mutex_lock(&state->lock);
+        for (int i = 0; i < total_found; i++)
+            add_match(state, &found[i]);
+        state->totals.total_scanned += total_chunk;
+        state->totals.total_abandoned += total_abandoned;
+        pthread_mutex_unlock(&state->lock);
+    }
+
+    maze_walls_free(walls);
+    maze_walls_free(candidate.walls);
+    free(candidate.rooms);
+    free(candidate.queue);
+    free(candidate.distances);
+
+    return NULL;
+}
+
+int seed_search(int size, unsigned int direction_options, const struct seed_predicate *predicate,
+                unsigned long long first_seed, long long total_seeds, int wanted, int total_threads,
+                struct seed_match *matches, struct seed_search_totals *totals)
+{
+    if (total_threads < 1)
+        total_threads = 1;
+
+    struct search_state state;
+    pthread_mutex_init(&state.lock, NULL);
+    state.size = size;
+    state.direction_options = direction_options;
+    state.predicate = predicate;
+    state.first_seed = first_seed;
+    state.total_seeds = total_seeds > 0 ? total_seeds : LLONG_MAX;
+    state.wanted = wanted;
+    state.next_offset = 0;
+    state.cutoff = wanted > 0 ? LLONG_MAX : 0;
+    state.matches = matches;
+    state.total_matches = 0;
+    state.totals.total_scanned = 0;
+    state.totals.total_abandoned = 0;
+
+    pthread_t *threads = (pthread_t *)calloc(total_threads, sizeof(pthread_t));
+    bool *started = (bool *)calloc(total_threads, sizeof(bool));
+
+    // Threads take seeds from the shared counter, so the ones that don't
+    // start only cost speed
+    for (int t = 1; t < total_threads; t++)
+        started[t] = pthread_create(&threads[t], NULL, search_thread, &state) == 0;
+
+    search_thread(&state);
+
+    for (int t = 1; t < total_threads; t++)
+    {
+        if (started[t])
+            pthread_join(threads[t], NULL);
+    }
+
+    free(threads);
+    free(started);
+    pthread_mutex_destroy(&state.lock);
+
+    if (totals)
+        *totals = state.totals;
+
+    return state.total_matches;
+}
+
+void fprint_seed_match(FILE *stream, const struct seed_match *match)
+{
+    fprintf(stream, "seed %llu", match->seed);
+    for (int i = 0; i < TOTAL_SEARCH_METRICS; i++)
+        fprintf(stream, " %s %d", seed_metric_names[i], match->metrics[i]);
+    fprintf(stream, "\n");
+}
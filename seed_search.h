@@ -0,0 +1,79 @@
+//
+//  seed_search.h
+//  kruskal-maze-generation-c
+//
+//  Created by Ezzat Chamudi on 10/19/26.
+//  Copyright © 2026 Ezzat Chamudi. All rights reserved.
+//  License: Apache-2.0
+//
+
+#ifndef seed_search_h
+#define seed_search_h
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include "definitions.h"
+#include "maze_walls.h"
+
+// Per-maze metrics a search can constrain
+#define SEARCH_DEG1 0
+#define SEARCH_DEG2 1
+#define SEARCH_DEG3 2
+#define SEARCH_DEG4 3
+#define SEARCH_PASSES 4
+#define SEARCH_FAILED_PASSES 5
+#define SEARCH_LETTERS 6  // Letter-S moves
+#define SEARCH_SOLUTION 7 // Cells on the path from (0, 0) to (size - 1, size - 1)
+#define SEARCH_LONGEST 8  // Cells on the longest path in the maze
+#define TOTAL_SEARCH_METRICS 9
+
+// Seeds claimed by a thread at a time
+#define SEED_SEARCH_CHUNK 64
+
+extern const char *seed_metric_names[TOTAL_SEARCH_METRICS];
+
+// Inclusive range per metric; a maze matches when every metric is in range
+struct seed_predicate {
+    int minimums[TOTAL_SEARCH_METRICS];
+    int maximums[TOTAL_SEARCH_METRICS];
+};
+
+struct seed_match {
+    unsigned long long seed;
+    int metrics[TOTAL_SEARCH_METRICS];
+};
+
+struct seed_search_totals {
+    long long total_scanned;
+    long long total_abandoned; // Stopped before the maze was finished
+};
+
+extern void seed_predicate_init(struct seed_predicate *predicate);
+
+// Narrows the predicate by one condition: "<metric><op><value>" with op one
+// of <, <=, =, >=, >, or "<metric>=<low>..<high>", e.g. "deg1>=30",
+// "solution=40..60". Returns false when the condition doesn't parse.
+extern bool seed_predicate_add(struct seed_predicate *predicate, const char *condition);
+
+// Generates maze seed, first_seed + 1, ... (each with rng_seed(seed), as the
+// log mode and the Python generate() do) on total_threads threads and
+// writes the first wanted matches to matches, lowest seed first. Stops after
+// total_seeds seeds (no limit when <= 0) or once the first wanted matches
+// are known. The result doesn't depend on the thread count.
+//
+// While a maze is being generated, its monotone partial metrics bound the
+// final ones: passes, letter-S moves, degree-4 cells and cells of degree 2
+// or more only grow, dead ends are 2 + (cells of degree >= 3) + (degree-4
+// cells) in a finished tree, and the solution is fixed once its two ends
+// share a room. A candidate is dropped as soon as a bound rules it out.
+//
+// Returns the number of matches found.
+extern int seed_search(int size, unsigned int direction_options, const struct seed_predicate *predicate,
+                       unsigned long long first_seed, long long total_seeds, int wanted, int total_threads,
+                       struct seed_match *matches, struct seed_search_totals *totals);
+
+extern void fprint_seed_match(FILE *stream, const struct seed_match *match);
+
+#endif /* seed_search_h */
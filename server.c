@@ -0,0 +1,379 @@
+//
+//  server.c
+//  kruskal-maze-generation-c
+//
+//  Created by Ezzat Chamudi on 10/19/26.
+//  Copyright © 2026 Ezzat Chamudi. All rights reserved.
+//  License: Apache-2.0
+//
+
+#include "server.h"
+
+#include <string.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+
+#include "print_maze.h"
+#include "randomized_kruskal.h"
+#include "rng.h"
+
+struct server_state {
+    const struct server_config *config;
+    struct maze_pool_set *pools;
+    struct lru_cache *cache;
+    pthread_mutex_t cache_lock;
+
+    // Service time of the most recent requests, in microseconds
+    pthread_mutex_t stats_lock;
+    long latencies[SERVER_LATENCY_SAMPLES];
+    long total_requests;
+    long total_generated;
+};
+
+struct connection_args {
+    struct server_state *state;
+    int fd;
+};
+
+static long elapsed_us(struct timespec start, struct timespec end)
+{
+    return (end.tv_sec - start.tv_sec) * 1000000L + (end.tv_nsec - start.tv_nsec) / 1000L;
+}
+
+static int compare_long(const void *a, const void *b)
+{
+    long x = *(const long *)a;
+    long y = *(const long *)b;
+    return (x > y) - (x < y);
+}
+
+static void record_latency(struct server_state *state, long latency, bool generated)
+{
+    pthread_mutex_lock(&state->stats_lock);
+    state->latencies[state->total_requests % SERVER_LATENCY_SAMPLES] = latency;
+    state->total_requests++;
+    if (generated)
+        state->total_generated++;
+    pthread_mutex_unlock(&state->stats_lock);
+}
+
+static void write_stats(struct server_state *state, FILE *out)
+{
+    static long sorted[SERVER_LATENCY_SAMPLES];
+    static pthread_mutex_t sorted_lock = PTHREAD_MUTEX_INITIALIZER;
+
+    pthread_mutex_lock(&sorted_lock);
+
+    pthread_mutex_lock(&state->stats_lock);
+    long total_requests = state->total_requests;
+    long total_generated = state->total_generated;
+    int total_samples = total_requests < SERVER_LATENCY_SAMPLES ? (int)total_requests : SERVER_LATENCY_SAMPLES;
+    memcpy(sorted, state->latencies, total_samples * sizeof(long));
+    pthread_mutex_unlock(&state->stats_lock);
+
+    qsort(sorted, total_samples, sizeof(long), compare_long);
+
+    long p50 = total_samples ? sorted[(total_samples - 1) / 2] : 0;
+    long p99 = total_samples ? sorted[(total_samples * 99 + 99) / 100 - 1] : 0;
+
+    pthread_mutex_unlock(&sorted_lock);
+
+    fprintf(out, "requests %ld\n", total_requests);
+    fprintf(out, "generated %ld\n", total_generated);
+    fprintf(out, "latency_p50_us %ld\n", p50);
+    fprintf(out, "latency_p99_us %ld\n", p99);
+
+    pthread_mutex_lock(&state->pools->lock);
+    for (int i = 0; i < state->pools->total_pools; i++)
+    {
+        struct maze_pool *pool = &state->pools->pools[i];
+        long lookups = pool->hits + pool->misses;
+
+        fprintf(out, "pool %d 0b%d%d%d%d%d ready %d/%d hits %ld misses %ld hit_rate %.3f\n",
+                pool->config.size,
+                (pool->config.direction_options & LETTER_PREPASS) != 0,
+                (pool->config.direction_options & UNIFORM_SAMPLING) != 0,
+                (pool->config.direction_options & ENABLE_LETTERS) != 0,
+                (pool->config.direction_options & ENABLE_DIAGONAL) != 0,
+                (pool->config.direction_options & ENABLE_STANDARD) != 0,
+                pool->total_mazes, pool->config.capacity,
+                pool->hits, pool->misses,
+                lookups ? (double)pool->hits / lookups : 0.0);
+    }
+    pthread_mutex_unlock(&state->pools->lock);
+
+    pthread_mutex_lock(&state->cache_lock);
+    long lookups = state->cache->hits + state->cache->misses;
+    fprintf(out, "cache entries %d bytes %zu hits %ld misses %ld hit_rate %.3f\n",
+            state->cache->total_entries, state->cache->bytes,
+            state->cache->hits, state->cache->misses,
+            lookups ? (double)state->cache->hits / lookups : 0.0);
+    pthread_mutex_unlock(&state->cache_lock);
+
+    fprintf(out, "END\n");
+}
+
+// Returns a maze owned by the caller. source tells where it came from.
+static struct maze_walls *serve_maze(struct server_state *state, int size, unsigned int direction_options,
+                                     bool seeded, unsigned long long seed, struct rng *rng, const char **source)
+{
+    struct maze_walls *walls = NULL;
+
+    if (seeded)
+    {
+        struct cache_key key = {size, direction_options, (long long)seed};
+
+        pthread_mutex_lock(&state->cache_lock);
+        struct maze_walls *cached = lru_cache_get(state->cache, key);
+        if (cached)
+            walls = maze_walls_copy(cached);
+        pthread_mutex_unlock(&state->cache_lock);
+
+        if (walls)
+        {
+            *source = "cache";
+            return walls;
+        }
+
+        struct rng seeded_rng;
+        rng_seed(&seeded_rng, seed);
+
+        walls = maze_walls_create(size);
+        randomized_kruskal_walls(false, walls, direction_options, &seeded_rng, NULL);
+
+        pthread_mutex_lock(&state->cache_lock);
+        lru_cache_put(state->cache, key, maze_walls_copy(walls));
+        pthread_mutex_unlock(&state->cache_lock);
+
+        *source = "generated";
+        return walls;
+    }
+
+    walls = maze_pool_take(state->pools, size, direction_options);
+    if (walls)
+    {
+        *source = "pool";
+        return walls;
+    }
+
+    walls = maze_walls_create(size);
+    randomized_kruskal_walls(false, walls, direction_options, rng, NULL);
+
+    *source = "generated";
+    return walls;
+}
+
+bool server_maze_valid(const struct server_config *config, int size, unsigned int direction_options)
+{
+    return size >= 2 && size <= config->max_size
+        && (direction_options & ENABLE_STANDARD)
+        && !(direction_options & ~(unsigned int)(ENABLE_STANDARD | ENABLE_DIAGONAL | ENABLE_LETTERS | UNIFORM_SAMPLING | LETTER_PREPASS));
+}
+
+static void *handle_connection(void *data)
+{
+    struct connection_args *args = (struct connection_args *)data;
+    struct server_state *state = args->state;
+    int fd = args->fd;
+    free(args);
+
+    FILE *in = fdopen(fd, "r");
+    if (in == NULL)
+    {
+        close(fd);
+        return NULL;
+    }
+
+    int out_fd = dup(fd);
+    FILE *out = out_fd >= 0 ? fdopen(out_fd, "w") : NULL;
+    if (out == NULL)
+    {
+        if (out_fd >= 0)
+            close(out_fd);
+        fclose(in);
+        return NULL;
+    }
+
+    struct rng rng;
+    rng_seed(&rng, (unsigned long long)time(NULL) ^ ((unsigned long long)fd << 40) ^ (unsigned long long)(size_t)&rng);
+
+    char line[256];
+    while (fgets(line, sizeof(line), in))
+    {
+        char command[16] = "";
+        char options_text[32] = "";
+        int size = 0;
+        unsigned long long seed = 0;
+
+        int total_fields = sscanf(line, "%15s %d %31s %llu", command, &size, options_text, &seed);
+
+        if (total_fields < 1)
+            continue;
+
+        if (strcmp(command, "QUIT") == 0)
+            break;
+
+        if (strcmp(command, "STATS") == 0)
+        {
+            write_stats(state, out);
+            fflush(out);
+            continue;
+        }
+
+        bool binary = strcmp(command, "MAZE") == 0;
+        bool text = strcmp(command, "PRINT") == 0;
+
+        if (!binary && !text)
+        {
+            fprintf(out, "ERR unknown command\n");
+            fflush(out);
+            continue;
+        }
+
+        unsigned int direction_options = total_fields >= 3 ? parse_direction_options(options_text) : 0;
+
+        if (total_fields < 3 || !server_maze_valid(state->config, size, direction_options))
+        {
+            fprintf(out, "ERR usage: MAZE|PRINT <size 2..%d> <options with 0b001 set> [seed]\n", state->config->max_size);
+            fflush(out);
+            continue;
+        }
+
+        struct timespec start, end;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+
+        const char *source;
+        struct maze_walls *walls = serve_maze(state, size, direction_options, total_fields == 4, seed, &rng, &source);
+
+        if (binary)
+        {
+            fprintf(out, "OK %d %u %s %d\n", size, direction_options, source, size * size);
+            fwrite(walls->cells, 1, (size_t)size * size, out);
+        }
+        else
+        {
+            fprintf(out, "OK %d %u %s\n", size, direction_options, source);
+            fprint_maze_walls(out, walls);
+        }
+        fflush(out);
+
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        record_latency(state, elapsed_us(start, end), strcmp(source, "generated") == 0);
+
+        maze_walls_free(walls);
+    }
+
+    fclose(out);
+    fclose(in);
+    return NULL;
+}
+
+int run_server(const struct server_config *config)
+{
+    // Pools are refilled in the background, where a bad configuration would
+    // take the whole server down
+    for (int i = 0; i < config->total_pools; i++)
+    {
+        const struct maze_pool_config *pool = &config->pools[i];
+        if (!server_maze_valid(config, pool->size, pool->direction_options) || pool->capacity < 1)
+        {
+            printf("ERROR: Bad pool %d:%u:%d, expected size 2..%d, options with 0b001 set and capacity >= 1.\n",
+                   pool->size, pool->direction_options, pool->capacity, config->max_size);
+            return 1;
+        }
+    }
+
+    if (config->total_workers < 1)
+    {
+        printf("ERROR: Need at least one worker.\n");
+        return 1;
+    }
+
+    struct sockaddr_un address;
+    if (strlen(config->socket_path) >= sizeof(address.sun_path))
+    {
+        printf("ERROR: Socket path %s is longer than %d bytes.\n", config->socket_path, (int)sizeof(address.sun_path) - 1);
+        return 1;
+    }
+
+    // Only a stale socket may be replaced, never a regular file or a symlink
+    struct stat existing;
+    bool stale_socket = false;
+    if (lstat(config->socket_path, &existing) == 0)
+    {
+        stale_socket = S_ISSOCK(existing.st_mode);
+        if (!stale_socket)
+        {
+            printf("ERROR: %s exists and is not a socket.\n", config->socket_path);
+            return 1;
+        }
+    }
+
+    struct server_state state;
+    memset(&state, 0, sizeof(state));
+
+    state.config = config;
+    state.cache = lru_cache_create(config->cache_bytes);
+    pthread_mutex_init(&state.cache_lock, NULL);
+    pthread_mutex_init(&state.stats_lock, NULL);
+
+    // Clients hanging up mid-response must not kill the server
+    signal(SIGPIPE, SIG_IGN);
+
+    int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listener < 0)
+    {
+        printf("ERROR: Can't create socket.\n");
+        return 1;
+    }
+
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strcpy(address.sun_path, config->socket_path);
+
+    if (stale_socket)
+        unlink(config->socket_path);
+
+    if (bind(listener, (struct sockaddr *)&address, sizeof(address)) < 0 || listen(listener, 64) < 0)
+    {
+        printf("ERROR: Can't listen on %s.\n", config->socket_path);
+        close(listener);
+        return 1;
+    }
+
+    state.pools = maze_pool_set_create(config->pools, config->total_pools, config->total_workers);
+    if (state.pools == NULL)
+    {
+        printf("ERROR: Can't start the pool workers.\n");
+        close(listener);
+        return 1;
+    }
+
+    printf("Serving mazes on %s (%d pools, %d workers).\n", config->socket_path, config->total_pools, config->total_workers);
+    fflush(stdout);
+
+    while (1)
+    {
+        int fd = accept(listener, NULL, NULL);
+        if (fd < 0)
+            continue;
+
+        struct connection_args *args = (struct connection_args *)calloc(1, sizeof(struct connection_args));
+        args->state = &state;
+        args->fd = fd;
+
+        pthread_t thread;
+        if (pthread_create(&thread, NULL, handle_connection, args) != 0)
+        {
+            close(fd);
+            free(args);
+            continue;
+        }
+        pthread_detach(thread);
+    }
+}
@@ -0,0 +1,37 @@
+//
+//  server.h
+//  kruskal-maze-generation-c
+//
+//  Created by Ezzat Chamudi on 10/19/26.
+//  Copyright © 2026 Ezzat Chamudi. All rights reserved.
+//  License: Apache-2.0
+//
+
+#ifndef server_h
+#define server_h
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include "definitions.h"
+#include "lru_cache.h"
+#include "maze_pool.h"
+
+#define SERVER_LATENCY_SAMPLES 8192
+
+struct server_config {
+    const char *socket_path;
+    struct maze_pool_config *pools;
+    int total_pools;
+    int total_workers;
+    size_t cache_bytes;
+    int max_size;
+};
+
+// Whether a maze of this size and these options can be served: options
+// without standard links can fail to join all rooms
+extern bool server_maze_valid(const struct server_config *config, int size, unsigned int direction_options);
+extern int run_server(const struct server_config *config);
+
+#endif /* server_h */
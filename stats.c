@@ -9,33 +9,104 @@
 
 #include "stats.h"
 
+static double seconds_since(struct timeval start)
+{
+    struct timeval end;
+    gettimeofday(&end, NULL);
+    return (end.tv_sec - start.tv_sec) + (end.tv_usec - start.tv_usec) / 1e6;
+}
+
 void stats(unsigned int direction_options)
+{
+    stats_with(direction_options, STATS_SERIAL);
+}
+
+void stats_with(unsigned int direction_options, int backend)
 {
     int size = 10;
     int trials = 100000;
 
+    // The lockstep kernel only knows the original selection
+    if (backend == STATS_BATCH && (direction_options & (UNIFORM_SAMPLING | LETTER_PREPASS)))
+    {
+        printf("Batch backend has no uniform sampling or letter-S pre-pass; using serial.\n");
+        backend = STATS_SERIAL;
+    }
+
+    // Keep srand() in control of the result
+    unsigned long long seed = ((unsigned long long)rand() << 32) ^ (unsigned long long)rand();
+
+    struct stats_result result;
+    stats_run(size, trials, direction_options, backend, seed, &result);
+
+    printf("Avg deg 1 nodes: %lf\n", result.avg_deg1_nodes);
+    printf("Avg deg 2 nodes: %lf\n", result.avg_deg2_nodes);
+    printf("Avg deg 3 nodes: %lf\n", result.avg_deg3_nodes);
+    printf("Avg deg 4 nodes: %lf\n", result.avg_deg4_nodes);
+    printf("Avg passes: %lf\n", result.avg_passes);
+    printf("Avg failed passes: %lf\n", result.avg_failed_passes);
+
+    if (backend == STATS_BATCH)
+        printf("Backend: batch (%s, %d lanes)\n", batch_kruskal_backend(), batch_kruskal_lanes());
+    else
+        printf("Backend: serial\n");
+    printf("Mazes per second: %.0f\n", result.mazes_per_second);
+}
+
+void stats_run(int size, int trials, unsigned int direction_options, int backend, unsigned long long seed, struct stats_result *result)
+{
     // Calculate average of passes
     double avg_deg1_nodes = 0;
     double avg_deg2_nodes = 0;
     double avg_deg3_nodes = 0;
     double avg_deg4_nodes = 0;
+    double avg_passes = 0;
+    double avg_failed_passes = 0;
+
+    struct timeval start;
+    gettimeofday(&start, NULL);
 
-    for (int i = 0; i < trials; i++)
+    if (backend == STATS_BATCH)
     {
-        struct maze my_maze = randomized_kruskal(false, size, direction_options);
-        avg_deg1_nodes += (double)my_maze.total_deg1_nodes / trials;
-        avg_deg2_nodes += (double)my_maze.total_deg2_nodes / trials;
-        avg_deg3_nodes += (double)my_maze.total_deg3_nodes / trials;
-        avg_deg4_nodes += (double)my_maze.total_deg4_nodes / trials;
-
-        // Free mems
-        for (int i = 0; i < size * size; i++)
-            free(my_maze.graph[i]);
-        free(my_maze.graph);
+        struct batch_totals totals;
+        batch_kruskal(size, direction_options, trials, seed, &totals);
+
+        avg_deg1_nodes = (double)totals.total_deg1_nodes / trials;
+        avg_deg2_nodes = (double)totals.total_deg2_nodes / trials;
+        avg_deg3_nodes = (double)totals.total_deg3_nodes / trials;
+        avg_deg4_nodes = (double)totals.total_deg4_nodes / trials;
+        avg_passes = (double)totals.total_passes / trials;
+        avg_failed_passes = (double)totals.total_failed_passes / trials;
+    }
+    else
+    {
+        // One maze buffer and one seeded stream; no shared state, so this
+        // can run on several threads at once
+        struct maze_walls *walls = maze_walls_create(size);
+        struct rng rng;
+        rng_seed(&rng, seed);
+
+        for (int i = 0; i < trials; i++)
+        {
+            memset(walls->cells, 0, walls->total_cells);
+
+            struct maze my_maze = randomized_kruskal_walls(false, walls, direction_options, &rng, NULL);
+            avg_deg1_nodes += (double)my_maze.total_deg1_nodes / trials;
+            avg_deg2_nodes += (double)my_maze.total_deg2_nodes / trials;
+            avg_deg3_nodes += (double)my_maze.total_deg3_nodes / trials;
+            avg_deg4_nodes += (double)my_maze.total_deg4_nodes / trials;
+            avg_passes += (double)my_maze.total_passes / trials;
+            avg_failed_passes += (double)my_maze.total_failed_passes / trials;
+        }
+
+        maze_walls_free(walls);
     }
 
-    printf("Avg deg 1 nodes: %lf\n", avg_deg1_nodes);
-    printf("Avg deg 2 nodes: %lf\n", avg_deg2_nodes);
-    printf("Avg deg 3 nodes: %lf\n", avg_deg3_nodes);
-    printf("Avg deg 4 nodes: %lf\n", avg_deg4_nodes);
+    result->avg_deg1_nodes = avg_deg1_nodes;
+    result->avg_deg2_nodes = avg_deg2_nodes;
+    result->avg_deg3_nodes = avg_deg3_nodes;
+    result->avg_deg4_nodes = avg_deg4_nodes;
+    result->avg_passes = avg_passes;
+    result->avg_failed_passes = avg_failed_passes;
+    result->mazes_per_second = trials / seconds_since(start);
 }
@@ -12,10 +12,30 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
 
 #include "definitions.h"
+#include "batch_kruskal.h"
 #include "randomized_kruskal.h"
 
+// Backends of stats_with(): one maze at a time, or the lockstep batch kernel
+#define STATS_SERIAL 0
+#define STATS_BATCH 1
+
+// Averages per maze, as printed by stats()
+struct stats_result {
+    double avg_deg1_nodes;
+    double avg_deg2_nodes;
+    double avg_deg3_nodes;
+    double avg_deg4_nodes;
+    double avg_passes;
+    double avg_failed_passes;
+    double mazes_per_second;
+};
+
 extern void stats(unsigned int direction_options);
+extern void stats_with(unsigned int direction_options, int backend);
+extern void stats_run(int size, int trials, unsigned int direction_options, int backend, unsigned long long seed, struct stats_result *result);
 
 #endif /* stats_h */
@@ -0,0 +1,475 @@
+//
+//  stats_shard.c
+//  kruskal-maze-generation-c
+//
+//  Created by Ezzat Chamudi on 10/19/26.
+//  Copyright © 2026 Ezzat Chamudi. All rights reserved.
+//  License: Apache-2.0
+//
+
+#include "stats_shard.h"
+
+#include <limits.h>
+#include <math.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include "maze_walls.h"
+#include "randomized_kruskal.h"
+#include "rng.h"
+
+static const char *metric_names[TOTAL_STATS_METRICS] = {
+    "deg 1 nodes", "deg 2 nodes", "deg 3 nodes", "deg 4 nodes", "passes", "failed passes"
+};
+
+struct stats_shard *stats_shard_create(int size, unsigned int direction_options, unsigned long long seed)
+{
+    struct stats_shard *shard = (struct stats_shard *)calloc(1, sizeof(struct stats_shard));
+    shard->size = size;
+    shard->direction_options = direction_options;
+    shard->seed = seed;
+    shard->total_bins = size * size + 1;
+    shard->histograms = (long long *)calloc((size_t)4 * shard->total_bins, sizeof(long long));
+
+    if (shard->histograms == NULL)
+    {
+        free(shard);
+        return NULL;
+    }
+
+    for (int i = 0; i < TOTAL_STATS_METRICS; i++)
+    {
+        shard->minimums[i] = LLONG_MAX;
+        shard->maximums[i] = LLONG_MIN;
+    }
+
+    return shard;
+}
+
+void stats_shard_free(struct stats_shard *shard)
+{
+    if (shard == NULL)
+        return;
+    free(shard->histograms);
+    free(shard->ranges);
+    free(shard);
+}
+
+void stats_shard_add(struct stats_shard *shard, const struct maze *maze)
+{
+    long long values[TOTAL_STATS_METRICS] = {
+        maze->total_deg1_nodes,
+        maze->total_deg2_nodes,
+        maze->total_deg3_nodes,
+        maze->total_deg4_nodes,
+        maze->total_passes,
+        maze->total_failed_passes
+    };
+
+    for (int i = 0; i < TOTAL_STATS_METRICS; i++)
+    {
+        shard->sums[i] += values[i];
+        shard->sums_of_squares[i] += (unsigned __int128)values[i] * values[i];
+        if (values[i] < shard->minimums[i])
+            shard->minimums[i] = values[i];
+        if (values[i] > shard->maximums[i])
+            shard->maximums[i] = values[i];
+    }
+
+    for (int i = 0; i < 4; i++)
+        shard->histograms[i * shard->total_bins + values[i]]++;
+
+    shard->total_trials++;
+}
+
+static bool covers_any(const struct stats_shard *shard, long long first_trial, long long total_trials)
+{
+    for (int i = 0; i < shard->total_ranges; i++)
+    {
+        const struct stats_trial_range *range = &shard->ranges[i];
+        if (first_trial < range->first + range->total && range->first < first_trial + total_trials)
+            return true;
+    }
+    return false;
+}
+
+bool stats_shard_cover(struct stats_shard *shard, long long first_trial, long long total_trials)
+{
+    if (first_trial < 0 || total_trials < 0 || first_trial > LLONG_MAX - total_trials
+        || covers_any(shard, first_trial, total_trials))
+        return false;
+
+    if (total_trials == 0)
+        return true;
+
+    // Insert in order, then join it with the neighbours it touches
+    int at = 0;
+    while (at < shard->total_ranges && shard->ranges[at].first < first_trial)
+        at++;
+
+    shard->ranges = (struct stats_trial_range *)realloc(shard->ranges, (shard->total_ranges + 1) * sizeof(struct stats_trial_range));
+    memmove(&shard->ranges[at + 1], &shard->ranges[at], (shard->total_ranges - at) * sizeof(struct stats_trial_range));
+    shard->ranges[at].first = first_trial;
+    shard->ranges[at].total = total_trials;
+    shard->total_ranges++;
+
+    if (at + 1 < shard->total_ranges && shard->ranges[at].first + shard->ranges[at].total == shard->ranges[at + 1].first)
+    {
+        shard->ranges[at].total += shard->ranges[at + 1].total;
+        memmove(&shard->ranges[at + 1], &shard->ranges[at + 2], (shard->total_ranges - at - 2) * sizeof(struct stats_trial_range));
+        shard->total_ranges--;
+    }
+
+    if (at > 0 && shard->ranges[at - 1].first + shard->ranges[at - 1].total == shard->ranges[at].first)
+    {
+        shard->ranges[at - 1].total += shard->ranges[at].total;
+        memmove(&shard->ranges[at], &shard->ranges[at + 1], (shard->total_ranges - at - 1) * sizeof(struct stats_trial_range));
+        shard->total_ranges--;
+    }
+
+    return true;
+}
+
+bool stats_shard_run(struct stats_shard *shard, long long first_trial, long long total_trials)
+{
+    if (!stats_shard_cover(shard, first_trial, total_trials))
+        return false;
+
+    struct maze_walls *walls = maze_walls_create(shard->size);
+
+    for (long long trial = first_trial; trial < first_trial + total_trials; trial++)
+    {
+        struct rng rng;
+        rng_seed(&rng, rng_derive(shard->seed, trial));
+
+        memset(walls->cells, 0, walls->total_cells);
+
+        struct maze maze = randomized_kruskal_walls(false, walls, shard->direction_options, &rng, NULL);
+        stats_shard_add(shard, &maze);
+    }
+
+    maze_walls_free(walls);
+    return true;
+}
+
+bool stats_shard_merge(struct stats_shard *into, const struct stats_shard *from)
+{
+    // Only shards of the same run add up
+    if (into->size != from->size || into->direction_options != from->direction_options || into->seed != from->seed)
+        return false;
+
+    // Nor do shards that share a trial, which would be counted twice
+    for (int i = 0; i < from->total_ranges; i++)
+    {
+        if (covers_any(into, from->ranges[i].first, from->ranges[i].total))
+            return false;
+    }
+
+    for (int i = 0; i < from->total_ranges; i++)
+        stats_shard_cover(into, from->ranges[i].first, from->ranges[i].total);
+
+    for (int i = 0; i < TOTAL_STATS_METRICS; i++)
+    {
+        into->sums[i] += from->sums[i];
+        into->sums_of_squares[i] += from->sums_of_squares[i];
+        if (from->minimums[i] < into->minimums[i])
+            into->minimums[i] = from->minimums[i];
+        if (from->maximums[i] > into->maximums[i])
+            into->maximums[i] = from->maximums[i];
+    }
+
+    for (int i = 0; i < 4 * into->total_bins; i++)
+        into->histograms[i] += from->histograms[i];
+
+    into->total_trials += from->total_trials;
+    return true;
+}
+
+static void put_u64(unsigned char *bytes, unsigned long long value)
+{
+    for (int i = 0; i < 8; i++)
+        bytes[i] = (value >> (8 * i)) & 0xFF;
+}
+
+static unsigned long long get_u64(const unsigned char *bytes)
+{
+    unsigned long long value = 0;
+    for (int i = 0; i < 8; i++)
+        value |= (unsigned long long)bytes[i] << (8 * i);
+    return value;
+}
+
+static bool write_u64s(const long long *values, int count, FILE *stream)
+{
+    for (int i = 0; i < count; i++)
+    {
+        unsigned char bytes[8];
+        put_u64(bytes, (unsigned long long)values[i]);
+        if (fwrite(bytes, 1, sizeof(bytes), stream) != sizeof(bytes))
+            return false;
+    }
+    return true;
+}
+
+// Low word, then high word
+static bool write_u128s(const unsigned __int128 *values, int count, FILE *stream)
+{
+    for (int i = 0; i < count; i++)
+    {
+        long long words[2] = {(long long)(unsigned long long)values[i], (long long)(unsigned long long)(values[i] >> 64)};
+        if (!write_u64s(words, 2, stream))
+            return false;
+    }
+    return true;
+}
+
+static bool read_u64s(long long *values, int count, FILE *stream)
+{
+    for (int i = 0; i < count; i++)
+    {
+        unsigned char bytes[8];
+        if (fread(bytes, 1, sizeof(bytes), stream) != sizeof(bytes))
+            return false;
+        values[i] = (long long)get_u64(bytes);
+    }
+    return true;
+}
+
+static bool read_u128s(unsigned __int128 *values, int count, FILE *stream)
+{
+    for (int i = 0; i < count; i++)
+    {
+        long long words[2];
+        if (!read_u64s(words, 2, stream))
+            return false;
+        values[i] = ((unsigned __int128)(unsigned long long)words[1] << 64) | (unsigned long long)words[0];
+    }
+    return true;
+}
+
+bool stats_shard_write(const struct stats_shard *shard, FILE *stream)
+{
+    // Little-endian: magic, version, size, options, seed, trials, the
+    // covered trial ranges (count, then first and total of each), then the
+    // sums, squares (two words each), minimums, maximums and the four degree
+    // histograms
+    unsigned char header[32];
+    memcpy(header, STATS_SHARD_MAGIC, 4);
+    put_u64(header + 4, STATS_SHARD_VERSION);
+    put_u64(header + 12, ((unsigned long long)shard->direction_options << 32) | (unsigned int)shard->size);
+    put_u64(header + 20, shard->seed);
+    header[28] = header[29] = header[30] = header[31] = 0;
+
+    long long trials = shard->total_trials;
+    long long total_ranges = shard->total_ranges;
+
+    if (fwrite(header, 1, sizeof(header), stream) != sizeof(header)
+        || !write_u64s(&trials, 1, stream)
+        || !write_u64s(&total_ranges, 1, stream))
+        return false;
+
+    for (int i = 0; i < shard->total_ranges; i++)
+    {
+        long long range[2] = {shard->ranges[i].first, shard->ranges[i].total};
+        if (!write_u64s(range, 2, stream))
+            return false;
+    }
+
+    return write_u64s(shard->sums, TOTAL_STATS_METRICS, stream)
+        && write_u128s(shard->sums_of_squares, TOTAL_STATS_METRICS, stream)
+        && write_u64s(shard->minimums, TOTAL_STATS_METRICS, stream)
+        && write_u64s(shard->maximums, TOTAL_STATS_METRICS, stream)
+        && write_u64s(shard->histograms, 4 * shard->total_bins, stream);
+}
+
+struct stats_shard *stats_shard_read(FILE *stream)
+{
+    unsigned char header[32];
+
+    if (fread(header, 1, sizeof(header), stream) != sizeof(header)
+        || memcmp(header, STATS_SHARD_MAGIC, 4) != 0
+        || get_u64(header + 4) != STATS_SHARD_VERSION)
+        return NULL;
+
+    unsigned long long shape = get_u64(header + 12);
+    unsigned int size = (unsigned int)(shape & 0xFFFFFFFF);
+    if (size < 2 || size > MAZE_MAX_SIZE)
+        return NULL;
+
+    // The rest of the file has to hold at least the trials, range count,
+    // stats and histograms before they are allocated
+    long start = ftell(stream);
+    if (start < 0 || fseek(stream, 0, SEEK_END) != 0)
+        return NULL;
+    long file_length = ftell(stream);
+    if (file_length < 0 || fseek(stream, start, SEEK_SET) != 0)
+        return NULL;
+
+    // Sums, two-word squares, minimums and maximums; four histograms
+    unsigned long long needed = 16 + 8 * 5 * TOTAL_STATS_METRICS + 32 * ((unsigned long long)size * size + 1);
+    if (file_length < start || (unsigned long long)(file_length - start) < needed)
+        return NULL;
+
+    struct stats_shard *shard = stats_shard_create((int)size, (unsigned int)(shape >> 32), get_u64(header + 20));
+    if (shard == NULL)
+        return NULL;
+
+    // Ranges are non-empty and disjoint, so there are no more of them than
+    // trials, and their totals add up to the trials
+    long long total_trials = 0;
+    long long total_ranges = 0;
+    bool valid = read_u64s(&total_trials, 1, stream) && read_u64s(&total_ranges, 1, stream)
+        && total_trials >= 0 && total_ranges >= 0 && total_ranges <= total_trials;
+
+    long long covered = 0;
+    for (long long i = 0; valid && i < total_ranges; i++)
+    {
+        long long range[2];
+        valid = read_u64s(range, 2, stream) && range[1] > 0 && stats_shard_cover(shard, range[0], range[1]);
+        covered += valid ? range[1] : 0;
+    }
+
+    shard->total_trials = total_trials;
+
+    if (!valid || covered != total_trials
+        || !read_u64s(shard->sums, TOTAL_STATS_METRICS, stream)
+        || !read_u128s(shard->sums_of_squares, TOTAL_STATS_METRICS, stream)
+        || !read_u64s(shard->minimums, TOTAL_STATS_METRICS, stream)
+        || !read_u64s(shard->maximums, TOTAL_STATS_METRICS, stream)
+        || !read_u64s(shard->histograms, 4 * shard->total_bins, stream))
+    {
+        stats_shard_free(shard);
+        return NULL;
+    }
+
+    return shard;
+}
+
+int fprint_stats_shard_gaps(FILE *stream, const struct stats_shard *shard)
+{
+    int total_gaps = 0;
+    long long next = 0;
+
+    for (int i = 0; i < shard->total_ranges; i++)
+    {
+        if (shard->ranges[i].first > next)
+        {
+            fprintf(stream, "Missing trials [%lld, %lld)\n", next, shard->ranges[i].first);
+            total_gaps++;
+        }
+        next = shard->ranges[i].first + shard->ranges[i].total;
+    }
+
+    return total_gaps;
+}
+
+void stats_shard_moments(const struct stats_shard *shard, int metric, long double *mean, long double *stddev)
+{
+    long long n = shard->total_trials;
+
+    *mean = n > 0 ? (long double)shard->sums[metric] / n : 0;
+
+    // n * squares - sum^2 is exact while it fits in 128 bits, which avoids
+    // the cancellation of squares - mean * sum when the mean is large
+    const unsigned __int128 squares = shard->sums_of_squares[metric];
+    const unsigned __int128 sum = (unsigned long long)shard->sums[metric];
+    long double variance = 0;
+    if (n > 1 && squares <= ~(unsigned __int128)0 / (unsigned long long)n)
+        variance = (long double)((unsigned __int128)n * squares - sum * sum) / ((long double)n * (n - 1));
+    else if (n > 1)
+        variance = ((long double)squares - *mean * shard->sums[metric]) / (n - 1);
+    *stddev = variance > 0 ? sqrtl(variance) : 0;
+}
+
+void fprint_stats_shard(FILE *stream, const struct stats_shard *shard)
+{
+    long long n = shard->total_trials;
+
+    fprintf(stream, "Trials: %lld (size %d, options %u, seed %llu)\n", n, shard->size, shard->direction_options, shard->seed);
+    if (n == 0)
+        return;
+
+    fprintf(stream, "%-14s %12s %12s %8s %8s\n", "metric", "mean", "stddev", "min", "max");
+    for (int i = 0; i < TOTAL_STATS_METRICS; i++)
+    {
+        long double mean, stddev;
+        stats_shard_moments(shard, i, &mean, &stddev);
+
+        fprintf(stream, "%-14s %12.6Lf %12.6Lf %8lld %8lld\n", metric_names[i], mean,
+                stddev, shard->minimums[i], shard->maximums[i]);
+    }
+}
+
+struct stats_shard *stats_fork(int total_workers, int size, unsigned int direction_options, unsigned long long seed,
+                               long long total_trials, const char *directory)
+{
+    pid_t *workers = (pid_t *)calloc(total_workers, sizeof(pid_t));
+    char path[4096];
+
+    for (int w = 0; w < total_workers; w++)
+    {
+        workers[w] = fork();
+        if (workers[w] < 0)
+        {
+            perror("fork");
+            exit(1);
+        }
+
+        if (workers[w] == 0)
+        {
+            // Worker w takes trials [w * N / W, (w + 1) * N / W)
+            long long first_trial = total_trials * w / total_workers;
+            long long last_trial = total_trials * (w + 1) / total_workers;
+
+            struct stats_shard *shard = stats_shard_create(size, direction_options, seed);
+            if (shard == NULL || !stats_shard_run(shard, first_trial, last_trial - first_trial))
+                _exit(1);
+
+            snprintf(path, sizeof(path), "%s/shard-%d.kmst", directory, w);
+            FILE *file = fopen(path, "wb");
+            bool written = file != NULL && stats_shard_write(shard, file);
+            if (file != NULL && fclose(file) != 0)
+                written = false;
+
+            _exit(written ? 0 : 1);
+        }
+    }
+
+    struct stats_shard *result = stats_shard_create(size, direction_options, seed);
+    bool failed = result == NULL;
+
+    for (int w = 0; w < total_workers; w++)
+    {
+        int status;
+        if (waitpid(workers[w], &status, 0) < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0)
+        {
+            printf("ERROR: Worker %d failed.\n", w);
+            failed = true;
+            continue;
+        }
+
+        snprintf(path, sizeof(path), "%s/shard-%d.kmst", directory, w);
+        FILE *file = fopen(path, "rb");
+        struct stats_shard *shard = file ? stats_shard_read(file) : NULL;
+        if (file)
+            fclose(file);
+
+        if (shard == NULL || result == NULL || !stats_shard_merge(result, shard))
+        {
+            printf("ERROR: Can't merge %s.\n", path);
+            failed = true;
+        }
+        stats_shard_free(shard);
+    }
+
+    free(workers);
+
+    if (failed)
+    {
+        stats_shard_free(result);
+        return NULL;
+    }
+
+    return result;
+}
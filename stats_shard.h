@@ -0,0 +1,85 @@
+//
+//  stats_shard.h
+//  kruskal-maze-generation-c
+//
+//  Created by Ezzat Chamudi on 10/19/26.
+//  Copyright © 2026 Ezzat Chamudi. All rights reserved.
+//  License: Apache-2.0
+//
+
+#ifndef stats_shard_h
+#define stats_shard_h
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include "definitions.h"
+
+#define STATS_SHARD_MAGIC "KMST"
+#define STATS_SHARD_VERSION 3
+
+// Per-maze metrics, in file order
+#define STATS_DEG1 0
+#define STATS_DEG2 1
+#define STATS_DEG3 2
+#define STATS_DEG4 3
+#define STATS_PASSES 4
+#define STATS_FAILED_PASSES 5
+#define TOTAL_STATS_METRICS 6
+
+// Trials [first, first + total)
+struct stats_trial_range {
+    long long first;
+    long long total;
+};
+
+// Partial stats of a set of trial ranges. Everything is an integer total, so
+// shards merge exactly in any order. Trial i is always generated from
+// rng_derive(seed, i), so a run split over shards gives the same totals as
+// one run over the whole range. The ranges are kept sorted and coalesced, so
+// a merge can refuse to count a trial twice.
+struct stats_shard {
+    int size;
+    unsigned int direction_options;
+    unsigned long long seed;
+    long long total_trials;
+    struct stats_trial_range *ranges;
+    int total_ranges;
+    long long sums[TOTAL_STATS_METRICS];
+    // Passes squared pass 1e18 on big mazes, so a few trials would overflow
+    // 64 bits
+    unsigned __int128 sums_of_squares[TOTAL_STATS_METRICS];
+    long long minimums[TOTAL_STATS_METRICS];
+    long long maximums[TOTAL_STATS_METRICS];
+
+    // Exact histograms of the four degree counts, bins 0..size*size
+    int total_bins;
+    long long *histograms;
+};
+
+// NULL when the histograms can't be allocated
+extern struct stats_shard *stats_shard_create(int size, unsigned int direction_options, unsigned long long seed);
+extern void stats_shard_free(struct stats_shard *shard);
+extern void stats_shard_add(struct stats_shard *shard, const struct maze *maze);
+// Adds [first, first + total) to the covered trials; false if any of them
+// already are
+extern bool stats_shard_cover(struct stats_shard *shard, long long first_trial, long long total_trials);
+// Runs and adds the trials; false, without running any, if some are
+// already covered
+extern bool stats_shard_run(struct stats_shard *shard, long long first_trial, long long total_trials);
+// False, leaving into unchanged, for shards of another run or with
+// overlapping trials
+extern bool stats_shard_merge(struct stats_shard *into, const struct stats_shard *from);
+// Prints every trial range missing before the last covered trial; returns
+// how many there are
+extern int fprint_stats_shard_gaps(FILE *stream, const struct stats_shard *shard);
+extern bool stats_shard_write(const struct stats_shard *shard, FILE *stream);
+extern struct stats_shard *stats_shard_read(FILE *stream);
+// Sample mean and standard deviation of one metric
+extern void stats_shard_moments(const struct stats_shard *shard, int metric, long double *mean, long double *stddev);
+extern void fprint_stats_shard(FILE *stream, const struct stats_shard *shard);
+extern struct stats_shard *stats_fork(int total_workers, int size, unsigned int direction_options, unsigned long long seed,
+                                      long long total_trials, const char *directory);
+
+#endif /* stats_shard_h */
@@ -0,0 +1,580 @@
+//
+//  sweep.c
+//  kruskal-maze-generation-c
+//
+//  Created by Ezzat Chamudi on 10/19/26.
+//  Copyright © 2026 Ezzat Chamudi. All rights reserved.
+//  License: Apache-2.0
+//
+
+#include "sweep.h"
+
+#include <errno.h>
+#include <limits.h>
+#include <pthread.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+
+static const char *column_names[TOTAL_STATS_METRICS] = {
+    "deg1", "deg2", "deg3", "deg4", "passes", "failed_passes"
+};
+
+struct config_state {
+    long long chunk_trials;
+    int total_chunks;
+    int first_chunk; // Global index of chunk 0
+    int done_chunks;
+    struct stats_shard *totals; // While some chunks are done and some not
+};
+
+// Chunk indices owned by one worker. The owner takes from the front, thieves
+// from the back.
+struct work_deque {
+    pthread_mutex_t lock;
+    int *chunks;
+    int head;
+    int tail;
+};
+
+struct sweep_state {
+    const struct sweep_config *configs;
+    int total_configs;
+    unsigned long long seed;
+
+    struct config_state *config_states;
+    int *chunk_configs; // Config of each global chunk
+    int total_chunks;
+
+    struct work_deque *deques;
+    int total_threads;
+
+    // Guards everything below and the config states
+    pthread_mutex_t lock;
+    FILE *checkpoint;
+    FILE *results;
+    bool failed;
+    int total_done;
+    int total_resumed;
+    long long total_steals;
+    struct timeval start;
+};
+
+static void put_u32(unsigned char *bytes, unsigned int value)
+{
+    for (int i = 0; i < 4; i++)
+        bytes[i] = (value >> (8 * i)) & 0xFF;
+}
+
+static unsigned int get_u32(const unsigned char *bytes)
+{
+    unsigned int value = 0;
+    for (int i = 0; i < 4; i++)
+        value |= (unsigned int)bytes[i] << (8 * i);
+    return value;
+}
+
+static void put_u64(unsigned char *bytes, unsigned long long value)
+{
+    for (int i = 0; i < 8; i++)
+        bytes[i] = (value >> (8 * i)) & 0xFF;
+}
+
+static unsigned long long get_u64(const unsigned char *bytes)
+{
+    unsigned long long value = 0;
+    for (int i = 0; i < 8; i++)
+        value |= (unsigned long long)bytes[i] << (8 * i);
+    return value;
+}
+
+// Magic, version, seed, config count, then size, options and trials per
+// config. A checkpoint only resumes the sweep whose header it starts with.
+static unsigned char *sweep_header(const struct sweep_state *state, size_t *total_bytes)
+{
+    *total_bytes = 20 + (size_t)state->total_configs * 16;
+    unsigned char *header = (unsigned char *)malloc(*total_bytes);
+
+    memcpy(header, SWEEP_MAGIC, 4);
+    put_u32(header + 4, SWEEP_VERSION);
+    put_u64(header + 8, state->seed);
+    put_u32(header + 16, state->total_configs);
+
+    for (int i = 0; i < state->total_configs; i++)
+    {
+        unsigned char *config = header + 20 + (size_t)i * 16;
+        put_u32(config, state->configs[i].size);
+        put_u32(config + 4, state->configs[i].direction_options);
+        put_u64(config + 8, state->configs[i].total_trials);
+    }
+
+    return header;
+}
+
+static long long chunk_first_trial(const struct sweep_state *state, int chunk)
+{
+    const struct config_state *config = &state->config_states[state->chunk_configs[chunk]];
+    return (long long)(chunk - config->first_chunk) * config->chunk_trials;
+}
+
+static long long chunk_total_trials(const struct sweep_state *state, int chunk)
+{
+    int c = state->chunk_configs[chunk];
+    long long first_trial = chunk_first_trial(state, chunk);
+    long long remaining = state->configs[c].total_trials - first_trial;
+    return remaining < state->config_states[c].chunk_trials ? remaining : state->config_states[c].chunk_trials;
+}
+
+// Record: chunk, trials, the sums, the squares (low and high word each), the
+// minimums and maximums, then (bin, count) for every
+// nonzero histogram bin. A chunk fills at most 4 bins per trial, so this
+// stays small where the dense histograms of a big maze would not.
+static bool write_record(FILE *stream, int chunk, const struct stats_shard *shard)
+{
+    const int total_values = 1 + 5 * TOTAL_STATS_METRICS;
+    unsigned long long values[1 + 5 * TOTAL_STATS_METRICS];
+    values[0] = shard->total_trials;
+    for (int i = 0; i < TOTAL_STATS_METRICS; i++)
+    {
+        values[1 + i] = shard->sums[i];
+        values[1 + TOTAL_STATS_METRICS + 2 * i] = (unsigned long long)shard->sums_of_squares[i];
+        values[2 + TOTAL_STATS_METRICS + 2 * i] = (unsigned long long)(shard->sums_of_squares[i] >> 64);
+        values[1 + 3 * TOTAL_STATS_METRICS + i] = shard->minimums[i];
+        values[1 + 4 * TOTAL_STATS_METRICS + i] = shard->maximums[i];
+    }
+
+    unsigned int total_entries = 0;
+    for (int i = 0; i < 4 * shard->total_bins; i++)
+        total_entries += shard->histograms[i] != 0;
+
+    size_t total_bytes = 8 + 8 * total_values + (size_t)total_entries * 12;
+    unsigned char *record = (unsigned char *)malloc(total_bytes);
+    unsigned char *at = record;
+
+    put_u32(at, chunk);
+    put_u32(at + 4, total_entries);
+    at += 8;
+
+    for (int i = 0; i < total_values; i++, at += 8)
+        put_u64(at, values[i]);
+
+    for (int i = 0; i < 4 * shard->total_bins; i++)
+    {
+        if (shard->histograms[i] == 0)
+            continue;
+        put_u32(at, i);
+        put_u64(at + 4, (unsigned long long)shard->histograms[i]);
+        at += 12;
+    }
+
+    bool written = fwrite(record, 1, total_bytes, stream) == total_bytes && fflush(stream) == 0;
+    free(record);
+
+    // Done means on disk
+    return written && fsync(fileno(stream)) == 0;
+}
+
+static struct stats_shard *config_totals(struct sweep_state *state, int c)
+{
+    struct config_state *config = &state->config_states[c];
+    if (config->totals == NULL)
+        config->totals = stats_shard_create(state->configs[c].size, state->configs[c].direction_options, state->seed);
+    return config->totals;
+}
+
+// Reads one record into its config's totals. False at the end of the file,
+// on a torn record or on one that doesn't belong to this sweep, and false
+// with state->failed set when the totals can't be allocated.
+static bool read_record(struct sweep_state *state, FILE *stream, unsigned char *done)
+{
+    unsigned char prefix[8 + 8 * (1 + 5 * TOTAL_STATS_METRICS)];
+    if (fread(prefix, 1, sizeof(prefix), stream) != sizeof(prefix))
+        return false;
+
+    unsigned int chunk = get_u32(prefix);
+    unsigned int total_entries = get_u32(prefix + 4);
+    if (chunk >= (unsigned int)state->total_chunks || done[chunk]
+        || (long long)get_u64(prefix + 8) != chunk_total_trials(state, chunk))
+        return false;
+
+    int c = state->chunk_configs[chunk];
+    int total_bins = state->configs[c].size * state->configs[c].size + 1;
+    if (total_entries > 4 * (unsigned long long)total_bins)
+        return false;
+
+    size_t total_bytes = (size_t)total_entries * 12;
+    unsigned char *entries = (unsigned char *)malloc(total_bytes + 1);
+    bool complete = fread(entries, 1, total_bytes, stream) == total_bytes;
+    for (unsigned int i = 0; complete && i < total_entries; i++)
+        complete = get_u32(entries + (size_t)i * 12) < 4 * (unsigned int)total_bins;
+
+    struct stats_shard *totals = complete ? config_totals(state, c) : NULL;
+    if (complete && totals == NULL)
+    {
+        printf("ERROR: Can't allocate the stats for size %d.\n", state->configs[c].size);
+        state->failed = true;
+        complete = false;
+    }
+
+    if (complete)
+    {
+        const unsigned char *values = prefix + 8;
+
+        totals->total_trials += (long long)get_u64(values);
+        stats_shard_cover(totals, chunk_first_trial(state, chunk), chunk_total_trials(state, chunk));
+        for (int i = 0; i < TOTAL_STATS_METRICS; i++)
+        {
+            long long minimum = (long long)get_u64(values + 8 * (1 + 3 * TOTAL_STATS_METRICS + i));
+            long long maximum = (long long)get_u64(values + 8 * (1 + 4 * TOTAL_STATS_METRICS + i));
+
+            totals->sums[i] += (long long)get_u64(values + 8 * (1 + i));
+            totals->sums_of_squares[i] += ((unsigned __int128)get_u64(values + 8 * (2 + TOTAL_STATS_METRICS + 2 * i)) << 64)
+                | get_u64(values + 8 * (1 + TOTAL_STATS_METRICS + 2 * i));
+            if (minimum < totals->minimums[i])
+                totals->minimums[i] = minimum;
+            if (maximum > totals->maximums[i])
+                totals->maximums[i] = maximum;
+        }
+
+        for (unsigned int i = 0; i < total_entries; i++)
+        {
+            const unsigned char *entry = entries + (size_t)i * 12;
+            totals->histograms[get_u32(entry)] += (long long)get_u64(entry + 4);
+        }
+
+        done[chunk] = 1;
+    }
+
+    free(entries);
+    return complete;
+}
+
+static void format_options(char *text, unsigned int direction_options)
+{
+    // Five bits, like the 0b10111 spelling on the command line
+    text[0] = '0';
+    text[1] = 'b';
+    for (int bit = 4; bit >= 0; bit--)
+        text[6 - bit] = (direction_options >> bit) & 1 ? '1' : '0';
+    text[7] = '\0';
+}
+
+static void write_header_row(FILE *results)
+{
+    fprintf(results, "size\toptions\ttrials");
+    for (int i = 0; i < TOTAL_STATS_METRICS; i++)
+        fprintf(results, "\t%s\t%s_stddev\t%s_min\t%s_max", column_names[i], column_names[i], column_names[i], column_names[i]);
+    fprintf(results, "\n");
+}
+
+// Called with the lock held once every chunk of config c is in
+static void finish_config(struct sweep_state *state, int c)
+{
+    struct config_state *config = &state->config_states[c];
+    const struct stats_shard *totals = config->totals;
+    char options[8];
+    format_options(options, state->configs[c].direction_options);
+
+    fprintf(state->results, "%d\t%s\t%lld", state->configs[c].size, options, totals->total_trials);
+    for (int i = 0; i < TOTAL_STATS_METRICS; i++)
+    {
+        long double mean, stddev;
+        stats_shard_moments(totals, i, &mean, &stddev);
+        fprintf(state->results, "\t%.6Lf\t%.6Lf\t%lld\t%lld", mean, stddev, totals->minimums[i], totals->maximums[i]);
+    }
+    fprintf(state->results, "\n");
+
+    if (fflush(state->results) != 0)
+        state->failed = true;
+
+    stats_shard_free(config->totals);
+    config->totals = NULL;
+}
+
+static bool deque_pop_front(struct work_deque *deque, int *chunk)
+{
+    pthread_mutex_lock(&deque->lock);
+    bool found = deque->head < deque->tail;
+    if (found)
+        *chunk = deque->chunks[deque->head++];
+    pthread_mutex_unlock(&deque->lock);
+    return found;
+}
+
+static bool deque_steal_back(struct work_deque *deque, int *chunk)
+{
+    pthread_mutex_lock(&deque->lock);
+    bool found = deque->head < deque->tail;
+    if (found)
+        *chunk = deque->chunks[--deque->tail];
+    pthread_mutex_unlock(&deque->lock);
+    return found;
+}
+
+struct worker_job {
+    struct sweep_state *state;
+    int worker;
+};
+
+static void *sweep_worker(void *argument)
+{
+    struct worker_job *job = (struct worker_job *)argument;
+    struct sweep_state *state = job->state;
+    const int worker = job->worker;
+
+    while (1)
+    {
+        int chunk;
+        bool stolen = false;
+
+        pthread_mutex_lock(&state->lock);
+        bool failed = state->failed;
+        pthread_mutex_unlock(&state->lock);
+
+        if (failed)
+            break;
+
+        if (!deque_pop_front(&state->deques[worker], &chunk))
+        {
+            // Try the others, nearest first
+            for (int k = 1; k < state->total_threads && !stolen; k++)
+                stolen = deque_steal_back(&state->deques[(worker + k) % state->total_threads], &chunk);
+
+            if (!stolen)
+                break;
+        }
+
+        int c = state->chunk_configs[chunk];
+        struct stats_shard *shard = stats_shard_create(state->configs[c].size, state->configs[c].direction_options, state->seed);
+        bool ran = shard != NULL && stats_shard_run(shard, chunk_first_trial(state, chunk), chunk_total_trials(state, chunk));
+
+        pthread_mutex_lock(&state->lock);
+
+        struct stats_shard *totals = ran ? config_totals(state, c) : NULL;
+        if (totals == NULL)
+        {
+            if (!state->failed)
+                printf("ERROR: Can't allocate the stats for size %d.\n", state->configs[c].size);
+            state->failed = true;
+            pthread_mutex_unlock(&state->lock);
+            stats_shard_free(shard);
+            break;
+        }
+
+        if (!write_record(state->checkpoint, chunk, shard))
+            state->failed = true;
+
+        if (!stats_shard_merge(totals, shard))
+            state->failed = true;
+        state->total_steals += stolen;
+        state->total_done++;
+
+        struct config_state *config = &state->config_states[c];
+        if (++config->done_chunks == config->total_chunks)
+        {
+            struct timeval now;
+            gettimeofday(&now, NULL);
+            double seconds = (now.tv_sec - state->start.tv_sec) + (now.tv_usec - state->start.tv_usec) / 1e6;
+
+            char options[8];
+            format_options(options, state->configs[c].direction_options);
+            printf("[%d/%d chunks, %.1lf s] size %d options %s: %lld trials done\n", state->total_done,
+                   state->total_chunks, seconds, state->configs[c].size, options, state->configs[c].total_trials);
+            fflush(stdout);
+
+            finish_config(state, c);
+        }
+
+        pthread_mutex_unlock(&state->lock);
+        stats_shard_free(shard);
+    }
+
+    return NULL;
+}
+
+bool sweep_run(const struct sweep_config *configs, int total_configs, unsigned long long seed,
+               int total_threads, const char *directory)
+{
+    if (total_threads < 1)
+        total_threads = 1;
+
+    struct sweep_state state;
+    memset(&state, 0, sizeof(state));
+    state.configs = configs;
+    state.total_configs = total_configs;
+    state.seed = seed;
+    state.total_threads = total_threads;
+    pthread_mutex_init(&state.lock, NULL);
+
+    // Chunks of about SWEEP_CHUNK_CELLS cells
+    state.config_states = (struct config_state *)calloc(total_configs, sizeof(struct config_state));
+    for (int c = 0; c < total_configs; c++)
+    {
+        struct config_state *config = &state.config_states[c];
+        long long cells = (long long)configs[c].size * configs[c].size;
+
+        config->chunk_trials = SWEEP_CHUNK_CELLS / cells > 0 ? SWEEP_CHUNK_CELLS / cells : 1;
+        config->total_chunks = (int)((configs[c].total_trials + config->chunk_trials - 1) / config->chunk_trials);
+        config->first_chunk = state.total_chunks;
+        state.total_chunks += config->total_chunks;
+    }
+
+    state.chunk_configs = (int *)malloc((state.total_chunks + 1) * sizeof(int));
+    for (int c = 0; c < total_configs; c++)
+    {
+        for (int i = 0; i < state.config_states[c].total_chunks; i++)
+            state.chunk_configs[state.config_states[c].first_chunk + i] = c;
+    }
+
+    char path[4096];
+    if (mkdir(directory, 0777) != 0 && errno != EEXIST)
+    {
+        printf("ERROR: Can't create %s.\n", directory);
+        return false;
+    }
+
+    // Resume from the checkpoint, or start one
+    size_t header_bytes;
+    unsigned char *header = sweep_header(&state, &header_bytes);
+    unsigned char *done = (unsigned char *)calloc(state.total_chunks + 1, sizeof(unsigned char));
+
+    snprintf(path, sizeof(path), "%s/%s", directory, SWEEP_CHECKPOINT);
+    state.checkpoint = fopen(path, "r+b");
+
+    if (state.checkpoint != NULL)
+    {
+        unsigned char *found = (unsigned char *)malloc(header_bytes);
+        bool same = fread(found, 1, header_bytes, state.checkpoint) == header_bytes
+            && memcmp(found, header, header_bytes) == 0;
+        free(found);
+
+        if (!same)
+        {
+            printf("ERROR: %s is from a different sweep.\n", path);
+            fclose(state.checkpoint);
+            free(header);
+            free(done);
+            return false;
+        }
+
+        long good_end = ftell(state.checkpoint);
+        while (read_record(&state, state.checkpoint, done))
+        {
+            good_end = ftell(state.checkpoint);
+            state.total_resumed++;
+        }
+
+        // Drop a record torn by the interruption, unless reading stopped
+        // for lack of memory
+        fflush(state.checkpoint);
+        if (state.failed || ftruncate(fileno(state.checkpoint), good_end) != 0 || fseek(state.checkpoint, good_end, SEEK_SET) != 0)
+            state.failed = true;
+    }
+    else
+    {
+        state.checkpoint = fopen(path, "w+b");
+        if (state.checkpoint == NULL || fwrite(header, 1, header_bytes, state.checkpoint) != header_bytes
+            || fflush(state.checkpoint) != 0)
+            state.failed = true;
+    }
+    free(header);
+
+    // The table is rebuilt from the checkpoint, then grows row by row
+    snprintf(path, sizeof(path), "%s/%s", directory, SWEEP_RESULTS);
+    state.results = fopen(path, "w");
+
+    if (state.checkpoint == NULL || state.results == NULL || state.failed)
+    {
+        printf("ERROR: Can't write the sweep in %s.\n", directory);
+        if (state.checkpoint)
+            fclose(state.checkpoint);
+        if (state.results)
+            fclose(state.results);
+        free(done);
+        return false;
+    }
+
+    write_header_row(state.results);
+    for (int c = 0; c < total_configs; c++)
+    {
+        struct config_state *config = &state.config_states[c];
+        for (int i = 0; i < config->total_chunks; i++)
+            config->done_chunks += done[config->first_chunk + i];
+
+        if (config->done_chunks == config->total_chunks && config->total_chunks > 0)
+            finish_config(&state, c);
+    }
+    state.total_done = state.total_resumed;
+
+    // Deal the remaining chunks round robin, so every worker starts on the
+    // first configs and rows come out roughly in grid order
+    state.deques = (struct work_deque *)calloc(total_threads, sizeof(struct work_deque));
+    for (int t = 0; t < total_threads; t++)
+    {
+        pthread_mutex_init(&state.deques[t].lock, NULL);
+        state.deques[t].chunks = (int *)malloc((state.total_chunks / total_threads + 1) * sizeof(int));
+    }
+
+    int dealt = 0;
+    for (int chunk = 0; chunk < state.total_chunks; chunk++)
+    {
+        if (done[chunk])
+            continue;
+        struct work_deque *deque = &state.deques[dealt++ % total_threads];
+        deque->chunks[deque->tail++] = chunk;
+    }
+    free(done);
+
+    printf("Sweep: %d configs, %d chunks, %d already done, %d threads\n", total_configs, state.total_chunks,
+           state.total_resumed, total_threads);
+    fflush(stdout);
+
+    gettimeofday(&state.start, NULL);
+
+    struct worker_job *jobs = (struct worker_job *)calloc(total_threads, sizeof(struct worker_job));
+    pthread_t *threads = (pthread_t *)calloc(total_threads, sizeof(pthread_t));
+    bool *started = (bool *)calloc(total_threads, sizeof(bool));
+
+    // A worker that doesn't start leaves its deque to the thieves; worker 0
+    // only stops once every deque is empty
+    for (int t = 0; t < total_threads; t++)
+    {
+        jobs[t].state = &state;
+        jobs[t].worker = t;
+        if (t > 0)
+            started[t] = pthread_create(&threads[t], NULL, sweep_worker, &jobs[t]) == 0;
+    }
+
+    sweep_worker(&jobs[0]);
+
+    for (int t = 1; t < total_threads; t++)
+    {
+        if (started[t])
+            pthread_join(threads[t], NULL);
+    }
+
+    printf("Sweep done: %d chunks run, %lld stolen\n", state.total_done - state.total_resumed, state.total_steals);
+
+    bool written = !state.failed;
+    if (fclose(state.checkpoint) != 0 || fclose(state.results) != 0)
+        written = false;
+
+    for (int t = 0; t < total_threads; t++)
+    {
+        pthread_mutex_destroy(&state.deques[t].lock);
+        free(state.deques[t].chunks);
+    }
+    for (int c = 0; c < total_configs; c++)
+        stats_shard_free(state.config_states[c].totals);
+
+    free(state.deques);
+    free(jobs);
+    free(threads);
+    free(started);
+    free(state.config_states);
+    free(state.chunk_configs);
+    pthread_mutex_destroy(&state.lock);
+
+    return written;
+}
@@ -0,0 +1,53 @@
+//
+//  sweep.h
+//  kruskal-maze-generation-c
+//
+//  Created by Ezzat Chamudi on 10/19/26.
+//  Copyright © 2026 Ezzat Chamudi. All rights reserved.
+//  License: Apache-2.0
+//
+
+#ifndef sweep_h
+#define sweep_h
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include "definitions.h"
+#include "stats_shard.h"
+
+#define SWEEP_MAGIC "KMSW"
+#define SWEEP_VERSION 2
+
+// Cells generated per chunk, so a chunk costs about the same at any size:
+// ~40,000 trials of size 10, 4 of size 1000, one trial of anything bigger
+#define SWEEP_CHUNK_CELLS (1 << 22)
+
+// File names inside the sweep directory
+#define SWEEP_CHECKPOINT "checkpoint.kmsw"
+#define SWEEP_RESULTS "results.tsv"
+
+// One row of the sweep. Trial i of every config comes from
+// rng_derive(seed, i), like stats-shard, so a config's row equals
+// stats-shard <size> <options> <seed> 0 <trials>.
+struct sweep_config {
+    int size;
+    unsigned int direction_options;
+    long long total_trials;
+};
+
+// Runs every config as trial chunks on total_threads workers. Each worker
+// owns a deque of chunks, takes from its front and, once empty, steals from
+// the back of another's, so no thread idles while any chunk is left.
+//
+// Every finished chunk is appended to the checkpoint as compact partial stats
+// (sums and nonzero histogram bins) and flushed. Rerunning the same sweep on
+// the same directory skips those chunks; a torn last record is dropped. A row
+// is appended to the results table as soon as all chunks of its config are
+// in. Returns false when the directory holds a different sweep or can't be
+// written.
+extern bool sweep_run(const struct sweep_config *configs, int total_configs, unsigned long long seed,
+                      int total_threads, const char *directory);
+
+#endif /* sweep_h */
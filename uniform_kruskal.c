@@ -0,0 +1,300 @@
+//
+//  uniform_kruskal.c
+//  kruskal-maze-generation-c
+//
+//  Created by Ezzat Chamudi on 10/19/26.
+//  Copyright © 2026 Ezzat Chamudi. All rights reserved.
+//  License: Apache-2.0
+//
+
+#include "uniform_kruskal.h"
+
+#include "fenwick.h"
+#include "randomized_kruskal.h"
+
+// Selection with UNIFORM_SAMPLING: every legal (cell, direction) pair is
+// equally likely, letter-S included, and no pass fails.
+//
+// Per-cell counts of legal moves live in a Fenwick tree. A merge only changes
+// legality for cells whose 3x3 window sees two of the merged rooms, and every
+// such cell is next to a member of a room other than the largest one. Those
+// members are walked (small into large, so each cell is walked O(log n)
+// times) and the live cells around them recounted.
+//
+// The counts are indexed by the logical cell x * size + y, not by the
+// storage index, so a seed draws the same cells in every layout. Rooms and
+// member rings use the storage index like the other engines.
+
+struct uniform_state {
+    const struct maze_walls *walls;
+    unsigned int direction_options;
+    int *rooms;
+    int *room_sizes;
+    int *next_member;
+    unsigned char *moves;
+    struct fenwick *moves_tree;
+    int *stamps;
+    int stamp;
+    int *pending;
+    int total_pending;
+    int pending_capacity;
+};
+
+static void recount(struct uniform_state *state, int x, int y)
+{
+    const struct maze_walls *walls = state->walls;
+    int cell = x * walls->size + y;
+
+    struct coordinate node_mid;
+    node_mid.x = x;
+    node_mid.y = y;
+
+    int window[3][3];
+    room_window(window, state->rooms, walls, node_mid);
+
+    unsigned char directions[TOTAL_DIRECTIONS + 1];
+    unsigned char moves = legal_directions(directions, x, y, walls->size, state->direction_options, window);
+
+    if (moves != state->moves[cell])
+    {
+        fenwick_add(state->moves_tree, cell, (long long)moves - state->moves[cell]);
+        state->moves[cell] = moves;
+    }
+}
+
+static void queue_neighbourhood(struct uniform_state *state, struct coordinate member)
+{
+    int size = state->walls->size;
+
+    for (int dx = -1; dx <= 1; dx++)
+    {
+        for (int dy = -1; dy <= 1; dy++)
+        {
+            int x = member.x + dx;
+            int y = member.y + dy;
+            if (x < 0 || x >= size || y < 0 || y >= size)
+                continue;
+
+            // Merging never makes a move legal again, so dead cells stay dead
+            int cell = x * size + y;
+            if (state->moves[cell] == 0 || state->stamps[cell] == state->stamp)
+                continue;
+            state->stamps[cell] = state->stamp;
+
+            if (state->total_pending == state->pending_capacity)
+            {
+                state->pending_capacity *= 2;
+                state->pending = (int *)realloc(state->pending, state->pending_capacity * sizeof(int));
+            }
+            state->pending[state->total_pending++] = cell;
+        }
+    }
+}
+
+static void merge_rooms(struct uniform_state *state, struct coordinate *selected_nodes, int total_selected_nodes)
+{
+    const struct maze_walls *walls = state->walls;
+    int roots[9];
+
+    int largest = -1;
+    for (int i = 0; i < total_selected_nodes; i++)
+    {
+        roots[i] = find_room(state->rooms, maze_cell_index(walls, selected_nodes[i].x, selected_nodes[i].y));
+        if (largest < 0 || state->room_sizes[roots[i]] > state->room_sizes[largest])
+            largest = roots[i];
+    }
+
+    state->stamp++;
+    state->total_pending = 0;
+
+    for (int i = 0; i < total_selected_nodes; i++)
+    {
+        int root = roots[i];
+        if (root == largest)
+            continue;
+
+        int member = root;
+        do
+        {
+            queue_neighbourhood(state, maze_cell_coordinate(walls, member));
+            member = state->next_member[member];
+        } while (member != root);
+
+        // Splice the member rings and link the root under the largest room
+        int next = state->next_member[root];
+        state->next_member[root] = state->next_member[largest];
+        state->next_member[largest] = next;
+
+        state->rooms[root] = largest;
+        state->room_sizes[largest] += state->room_sizes[root];
+    }
+
+    for (int i = 0; i < state->total_pending; i++)
+        recount(state, state->pending[i] / walls->size, state->pending[i] % walls->size);
+}
+
+struct maze uniform_kruskal_walls(bool verbose, struct maze_walls *walls, unsigned int direction_options, struct rng *rng,
+                                  struct event_log *log, struct generation_watch *watch)
+{
+    struct maze result;
+
+    const int size = walls->size;
+    const int total_nodes = size * size;
+    const int total_cells = walls->total_cells;
+
+    struct uniform_state state;
+    state.walls = walls;
+    state.direction_options = direction_options;
+    state.rooms = (int *)maze_allocate(walls->allocator, (size_t)total_cells * sizeof(int));
+    state.room_sizes = (int *)calloc(total_cells, sizeof(int));
+    state.next_member = (int *)calloc(total_cells, sizeof(int));
+    state.moves = (unsigned char *)calloc(total_nodes, sizeof(unsigned char));
+    state.moves_tree = fenwick_create(total_nodes);
+    state.stamps = (int *)calloc(total_nodes, sizeof(int));
+    state.stamp = 0;
+    state.pending_capacity = 64;
+    state.pending = (int *)calloc(state.pending_capacity, sizeof(int));
+    state.total_pending = 0;
+
+    if (state.rooms == NULL)
+    {
+        printf("ERROR: Can't allocate rooms for size %d.\n", size);
+        exit(1);
+    }
+
+    for (int i = 0; i < total_cells; i++)
+    {
+        state.rooms[i] = i;
+        state.room_sizes[i] = 1;
+        state.next_member[i] = i;
+    }
+
+    int pass_number = 0;
+    int rooms_counter = total_nodes;
+    bool stopped = false;
+
+    // Bulk letter-S shapes go in before the first count, so their rooms are
+    // counted like any other
+    if ((direction_options & LETTER_PREPASS) && (direction_options & ENABLE_LETTERS))
+    {
+        int total_centers;
+        struct coordinate *centers = letter_prepass(size, rng, &total_centers);
+
+        for (int i = 0; i < total_centers; i++)
+        {
+            pass_number++;
+
+            struct coordinate selected_nodes[9];
+            direction_nodes(selected_nodes, centers[i], LETTER_S);
+            link_direction_nodes(walls, selected_nodes, LETTER_S);
+
+            if (log)
+                event_log_append(log, centers[i].x * size + centers[i].y, pass_number, LETTER_S);
+
+            // Nine fresh rooms, one ring
+            int root = maze_cell_index(walls, selected_nodes[0].x, selected_nodes[0].y);
+            for (int j = 1; j < 9; j++)
+            {
+                int cell = maze_cell_index(walls, selected_nodes[j].x, selected_nodes[j].y);
+                state.rooms[cell] = root;
+                state.next_member[cell] = state.next_member[root];
+                state.next_member[root] = cell;
+            }
+            state.room_sizes[root] = 9;
+            rooms_counter -= 8;
+
+            if (watch && !watch->merged(watch->context, centers[i].x * size + centers[i].y, pass_number, LETTER_S))
+            {
+                stopped = true;
+                break;
+            }
+        }
+
+        free(centers);
+    }
+
+    for (int x = 0; x < size; x++)
+    {
+        for (int y = 0; y < size; y++)
+            recount(&state, x, y);
+    }
+
+    while (rooms_counter > 1 && !stopped)
+    {
+        pass_number++;
+
+        long long total_moves = fenwick_sum(state.moves_tree);
+
+        if (total_moves == 0)
+        {
+            printf("ERROR: No legal move left. Can't combine all rooms using legal directions.\n");
+            fprint_maze_walls(stdout, walls);
+            exit(1);
+        }
+
+        long long target = (long long)(rng_next(rng) % (unsigned long long)total_moves);
+        int cell = fenwick_find(state.moves_tree, &target);
+
+        struct coordinate node_mid;
+        node_mid.x = cell / size;
+        node_mid.y = cell % size;
+
+        int window[3][3];
+        room_window(window, state.rooms, walls, node_mid);
+
+        unsigned char directions[TOTAL_DIRECTIONS + 1];
+        legal_directions(directions, node_mid.x, node_mid.y, size, direction_options, window);
+
+        int selected_direction = directions[target + 1];
+
+        if (verbose)
+        {
+            printf("Pass: %d; middle node (%d, %d); direction ", pass_number, node_mid.x, node_mid.y);
+            print_direction(selected_direction);
+            printf("\n");
+        }
+
+        struct coordinate selected_nodes[9];
+        int total_selected_nodes = direction_nodes(selected_nodes, node_mid, selected_direction);
+
+        link_direction_nodes(walls, selected_nodes, selected_direction);
+
+        if (log)
+            event_log_append(log, node_mid.x * size + node_mid.y, pass_number, selected_direction);
+
+        merge_rooms(&state, selected_nodes, total_selected_nodes);
+
+        rooms_counter -= total_selected_nodes - 1;
+
+        if (watch && !watch->merged(watch->context, node_mid.x * size + node_mid.y, pass_number, selected_direction))
+        {
+            stopped = true;
+            break;
+        }
+    }
+
+    // An unfinished maze has cells without passages
+    if (stopped)
+        result.total_deg1_nodes = result.total_deg2_nodes = result.total_deg3_nodes = result.total_deg4_nodes = 0;
+    else
+        count_degrees(&result, walls);
+
+    if (verbose)
+        printf("DONE! Total passes: %d\n\n", pass_number);
+
+    maze_release(walls->allocator, state.rooms, (size_t)total_cells * sizeof(int));
+    free(state.room_sizes);
+    free(state.next_member);
+    free(state.moves);
+    fenwick_free(state.moves_tree);
+    free(state.stamps);
+    free(state.pending);
+
+    result.total_passes = pass_number;
+    result.total_failed_passes = 0;
+    result.size = size;
+    result.graph = NULL;
+    result.total_nodes = total_nodes;
+
+    return result;
+}
@@ -0,0 +1,25 @@
+//
+//  uniform_kruskal.h
+//  kruskal-maze-generation-c
+//
+//  Created by Ezzat Chamudi on 10/19/26.
+//  Copyright © 2026 Ezzat Chamudi. All rights reserved.
+//  License: Apache-2.0
+//
+
+#ifndef uniform_kruskal_h
+#define uniform_kruskal_h
+
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include "definitions.h"
+#include "event_log.h"
+#include "generation_watch.h"
+#include "maze_walls.h"
+#include "rng.h"
+
+extern struct maze uniform_kruskal_walls(bool verbose, struct maze_walls *walls, unsigned int direction_options, struct rng *rng,
+                                         struct event_log *log, struct generation_watch *watch);
+
+#endif /* uniform_kruskal_h */
@@ -0,0 +1,69 @@
+//
+//  union_find_kruskal.c
+//  kruskal-maze-generation-c
+//
+//  Created by Ezzat Chamudi on 10/19/26.
+//  Copyright © 2026 Ezzat Chamudi. All rights reserved.
+//  License: Apache-2.0
+//
+
+#include "union_find_kruskal.h"
+
+#include "randomized_kruskal.h"
+
+// Textbook randomized Kruskal: visit the grid's edges in random order and
+// open each one that joins two different rooms.
+//
+// Cost: O(E α(n)) for E = 2 * size * (size - 1) edges. The shuffle is done
+// lazily (one Fisher-Yates step per edge visited) and stops once the tree is
+// complete. Every draw is used, so there are no failed passes. Memory is one
+// int per edge plus one per cell. Standard directions only.
+
+void union_find_kruskal_walls(struct maze_walls *walls, struct rng *rng)
+{
+    const int size = walls->size;
+    const int total_nodes = size * size;
+    const int total_edges = 2 * size * (size - 1);
+
+    // Edge e joins node e / 2 with its right (even e) or bottom (odd e) neighbour
+    int *edges = (int *)malloc((size_t)total_edges * sizeof(int));
+    int *rooms = (int *)malloc((size_t)total_nodes * sizeof(int));
+
+    int count = 0;
+    for (int node = 0; node < total_nodes; node++)
+    {
+        rooms[node] = node;
+
+        if (node / size + 1 < size)
+            edges[count++] = node * 2;
+        if (node % size + 1 < size)
+            edges[count++] = node * 2 + 1;
+    }
+
+    int merges = 0;
+    for (int i = 0; i < total_edges && merges < total_nodes - 1; i++)
+    {
+        int j = i + rng_range(rng, total_edges - i);
+        int edge = edges[j];
+        edges[j] = edges[i];
+        edges[i] = edge;
+
+        int a = edge / 2;
+        int b = (edge & 1) ? a + 1 : a + size;
+
+        int room_a = find_room(rooms, a);
+        int room_b = find_room(rooms, b);
+        if (room_a == room_b)
+            continue;
+
+        rooms[room_b] = room_a;
+        merges++;
+
+        struct coordinate node_a = {a / size, a % size};
+        struct coordinate node_b = {b / size, b % size};
+        maze_walls_link(walls, node_a, node_b);
+    }
+
+    free(edges);
+    free(rooms);
+}
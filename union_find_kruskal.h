@@ -0,0 +1,21 @@
+//
+//  union_find_kruskal.h
+//  kruskal-maze-generation-c
+//
+//  Created by Ezzat Chamudi on 10/19/26.
+//  Copyright © 2026 Ezzat Chamudi. All rights reserved.
+//  License: Apache-2.0
+//
+
+#ifndef union_find_kruskal_h
+#define union_find_kruskal_h
+
+#include <stdlib.h>
+
+#include "definitions.h"
+#include "maze_walls.h"
+#include "rng.h"
+
+extern void union_find_kruskal_walls(struct maze_walls *walls, struct rng *rng);
+
+#endif /* union_find_kruskal_h */
@@ -79,3 +79,12 @@ void print_direction(int code)
         break;
     }
 }
+
+unsigned int parse_direction_options(const char *text)
+{
+    // Accepts the same 0b00000111 spelling used in the code, or plain numbers
+    if (strncmp(text, "0b", 2) == 0)
+        return (unsigned int)strtoul(text + 2, NULL, 2);
+
+    return (unsigned int)strtoul(text, NULL, 0);
+}
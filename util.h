@@ -12,10 +12,13 @@
 
 #include <stdio.h>
 #include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
 #include "definitions.h"
 
 extern bool all_unique_3(int x, int y, int z);
 extern bool all_unique_array(int length, int array[]);
 extern void print_direction(int code);
+extern unsigned int parse_direction_options(const char *text);
 
 #endif /* util_h */
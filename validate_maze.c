@@ -0,0 +1,194 @@
+//
+//  validate_maze.c
+//  kruskal-maze-generation-c
+//
+//  Created by Ezzat Chamudi on 10/19/26.
+//  Copyright © 2026 Ezzat Chamudi. All rights reserved.
+//  License: Apache-2.0
+//
+
+#include "validate_maze.h"
+
+#include <string.h>
+
+struct maze_validator *maze_validator_create(void)
+{
+    return (struct maze_validator *)calloc(1, sizeof(struct maze_validator));
+}
+
+void maze_validator_free(struct maze_validator *validator)
+{
+    free(validator->queue);
+    free(validator->visited);
+    free(validator);
+}
+
+static void reserve(struct maze_validator *validator, int total_nodes)
+{
+    if (validator->capacity >= total_nodes)
+        return;
+
+    free(validator->queue);
+    free(validator->visited);
+
+    validator->capacity = total_nodes;
+    validator->queue = (int *)malloc(total_nodes * sizeof(int));
+    validator->visited = (unsigned char *)malloc(total_nodes * sizeof(unsigned char));
+}
+
+static struct maze_validation fail(struct maze_validation result, int cell, const char *error)
+{
+    result.valid = false;
+    result.bad_cell = cell;
+    result.error = error;
+    return result;
+}
+
+// A perfect maze is a spanning tree of the grid: every passage is mirrored by
+// its neighbour and stays inside the grid, there are exactly total_nodes - 1
+// passages, and one BFS reaches every cell. Connected with that many edges
+// also rules out cycles. Works on any width x height maze.
+struct maze_validation validate_maze(struct maze_validator *validator, const struct maze_walls *walls)
+{
+    return validate_maze_masked(validator, walls, NULL);
+}
+
+// The same over the live cells of mask, a NULL mask meaning all of them.
+// Masked cells count as outside, so a passage into one leaves the grid.
+struct maze_validation validate_maze_masked(struct maze_validator *validator, const struct maze_walls *walls,
+                                            const struct maze_mask *mask)
+{
+    struct maze_validation result;
+    result.valid = true;
+    result.total_edges = 0;
+    result.total_reached = 0;
+    result.bad_cell = -1;
+    result.error = NULL;
+
+    const int width = walls->width;
+    const int height = walls->height;
+    const unsigned char *cells = walls->cells;
+
+    int total_nodes = 0;
+    int first_node = -1;
+
+    // Local passages, every link is counted once from its left or top end
+    for (int x = 0; x < width; x++)
+    {
+        for (int y = 0; y < height; y++)
+        {
+            int cell = maze_cell_index(walls, x, y);
+            unsigned char passages = cells[cell];
+
+            if (mask != NULL && !maze_mask_live(mask, x, y))
+            {
+                if (passages != 0)
+                    return fail(result, cell, "masked cell has passages");
+                continue;
+            }
+
+            total_nodes++;
+            if (first_node < 0)
+                first_node = cell;
+
+            if (passages & ~(PASSAGE_TOP | PASSAGE_RIGHT | PASSAGE_BOTTOM | PASSAGE_LEFT))
+                return fail(result, cell, "unknown passage flags");
+
+            if (((passages & PASSAGE_TOP) && y == 0)
+                || ((passages & PASSAGE_RIGHT) && x == width - 1)
+                || ((passages & PASSAGE_BOTTOM) && y == height - 1)
+                || ((passages & PASSAGE_LEFT) && x == 0))
+                return fail(result, cell, "passage leaves the grid");
+
+            if (mask != NULL
+                && (((passages & PASSAGE_TOP) && !maze_mask_live(mask, x, y - 1))
+                    || ((passages & PASSAGE_RIGHT) && !maze_mask_live(mask, x + 1, y))
+                    || ((passages & PASSAGE_BOTTOM) && !maze_mask_live(mask, x, y + 1))
+                    || ((passages & PASSAGE_LEFT) && !maze_mask_live(mask, x - 1, y))))
+                return fail(result, cell, "passage leads into a masked cell");
+
+            if (y > 0 && ((passages & PASSAGE_TOP) != 0) != ((cells[maze_cell_index(walls, x, y - 1)] & PASSAGE_BOTTOM) != 0))
+                return fail(result, cell, "top passage is not mirrored");
+
+            if (x > 0 && ((passages & PASSAGE_LEFT) != 0) != ((cells[maze_cell_index(walls, x - 1, y)] & PASSAGE_RIGHT) != 0))
+                return fail(result, cell, "left passage is not mirrored");
+
+            result.total_edges += ((passages & PASSAGE_RIGHT) != 0) + ((passages & PASSAGE_BOTTOM) != 0);
+        }
+    }
+
+    if (total_nodes == 0)
+        return fail(result, -1, "no live cells");
+
+    if (result.total_edges != total_nodes - 1)
+        return fail(result, -1, result.total_edges < total_nodes - 1 ? "too few passages" : "too many passages");
+
+    // Connectivity
+    reserve(validator, walls->total_cells);
+    memset(validator->visited, 0, walls->total_cells);
+
+    int *queue = validator->queue;
+    int head = 0;
+    int tail = 0;
+
+    // Cell (0, 0) unless it's masked; it has index 0 in every layout
+    queue[tail++] = first_node;
+    validator->visited[first_node] = 1;
+
+    while (head < tail)
+    {
+        int cell = queue[head++];
+        unsigned char passages = cells[cell];
+        struct coordinate at = maze_cell_coordinate(walls, cell);
+        int neighbours[4] = {
+            (passages & PASSAGE_TOP) ? maze_cell_index(walls, at.x, at.y - 1) : -1,
+            (passages & PASSAGE_RIGHT) ? maze_cell_index(walls, at.x + 1, at.y) : -1,
+            (passages & PASSAGE_BOTTOM) ? maze_cell_index(walls, at.x, at.y + 1) : -1,
+            (passages & PASSAGE_LEFT) ? maze_cell_index(walls, at.x - 1, at.y) : -1
+        };
+
+        for (int i = 0; i < 4; i++)
+        {
+            int next = neighbours[i];
+            if (next >= 0 && !validator->visited[next])
+            {
+                validator->visited[next] = 1;
+                queue[tail++] = next;
+            }
+        }
+    }
+
+    result.total_reached = tail;
+
+    if (tail != total_nodes)
+    {
+        for (int x = 0; x < width; x++)
+        {
+            for (int y = 0; y < height; y++)
+            {
+                int cell = maze_cell_index(walls, x, y);
+                if (!validator->visited[cell] && (mask == NULL || maze_mask_live(mask, x, y)))
+                    return fail(result, cell, "cell is not connected");
+            }
+        }
+    }
+
+    return result;
+}
+
+int validate_maze_batch(struct maze_walls **mazes, int total_mazes, struct maze_validation *results)
+{
+    struct maze_validator *validator = maze_validator_create();
+    int total_invalid = 0;
+
+    for (int i = 0; i < total_mazes; i++)
+    {
+        results[i] = validate_maze(validator, mazes[i]);
+        if (!results[i].valid)
+            total_invalid++;
+    }
+
+    maze_validator_free(validator);
+
+    return total_invalid;
+}
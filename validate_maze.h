@@ -0,0 +1,43 @@
+//
+//  validate_maze.h
+//  kruskal-maze-generation-c
+//
+//  Created by Ezzat Chamudi on 10/19/26.
+//  Copyright © 2026 Ezzat Chamudi. All rights reserved.
+//  License: Apache-2.0
+//
+
+#ifndef validate_maze_h
+#define validate_maze_h
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include "definitions.h"
+#include "maze_mask.h"
+#include "maze_walls.h"
+
+struct maze_validation {
+    bool valid;
+    int total_edges;
+    int total_reached;
+    int bad_cell; // First offending cell, -1 when none
+    const char *error;
+};
+
+// Scratch space reused across a batch so validating allocates nothing per maze
+struct maze_validator {
+    int capacity;
+    int *queue;
+    unsigned char *visited;
+};
+
+extern struct maze_validator *maze_validator_create(void);
+extern void maze_validator_free(struct maze_validator *validator);
+extern struct maze_validation validate_maze(struct maze_validator *validator, const struct maze_walls *walls);
+extern struct maze_validation validate_maze_masked(struct maze_validator *validator, const struct maze_walls *walls,
+                                                   const struct maze_mask *mask);
+extern int validate_maze_batch(struct maze_walls **mazes, int total_mazes, struct maze_validation *results);
+
+#endif /* validate_maze_h */
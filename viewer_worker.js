@@ -0,0 +1,218 @@
+// Draws the maze viewer off the main thread, onto the OffscreenCanvas the
+// page transfers here. The maze lives in the WASM module loaded by this
+// worker; each frame asks it for one packed tile of the visible cells (or of
+// a downsampled level when zoomed out), so a frame costs about the same for
+// any maze size.
+
+var ready = false;
+var queued = [];
+
+var Module = {
+  // The wasm file sits next to script.js, not next to this worker
+  locateFile: function (path) {
+    return '/dist/' + path;
+  },
+  onRuntimeInitialized: function () {
+    ready = true;
+    flush();
+  }
+};
+
+importScripts('/dist/script.js');
+
+// Passage flags, see maze_walls.h and maze_tiles.h
+var PASSAGE_TOP = 0b0001;
+var PASSAGE_RIGHT = 0b0010;
+var PASSAGE_BOTTOM = 0b0100;
+var PASSAGE_LEFT = 0b1000;
+var MAZE_TILE_OUTSIDE = 0x80;
+
+var WALL_SHADE = 0x3a;
+var FLOOR_SHADE = 0xff;
+
+var canvas = null;
+var context = null;
+var scratch = null;
+var scratchContext = null;
+
+var maze = null;
+// Maze cell under the middle of the canvas, and screen pixels per cell
+var view = { x: 0, y: 0, cellPixels: 8 };
+var framePending = false;
+
+onmessage = function (event) {
+  queued.push(event.data);
+  if (ready) flush();
+};
+
+function flush() {
+  while (queued.length > 0) handle(queued.shift());
+  requestFrame();
+}
+
+function handle(message) {
+  if (message.type === 'canvas') {
+    canvas = message.canvas;
+    context = canvas.getContext('2d');
+  } else if (message.type === 'generate') {
+    var t0 = performance.now();
+    var levels = Module.ccall('web_viewer_generate', 'number', ['number', 'number', 'number'],
+      [message.size, message.directionOptions, message.seed | 0]);
+
+    maze = { size: message.size, levels: levels };
+    view.x = message.size / 2;
+    view.y = message.size / 2;
+    view.cellPixels = minimumCellPixels();
+
+    postMessage({ type: 'generated', milliseconds: performance.now() - t0, levels: levels });
+  } else if (maze && message.type === 'pan') {
+    view.x -= message.dx / view.cellPixels;
+    view.y -= message.dy / view.cellPixels;
+  } else if (maze && message.type === 'zoom') {
+    // Keep the cell under the pointer where it is
+    var beforeX = view.x + (message.px - canvas.width / 2) / view.cellPixels;
+    var beforeY = view.y + (message.py - canvas.height / 2) / view.cellPixels;
+
+    view.cellPixels = Math.min(64, Math.max(minimumCellPixels(), view.cellPixels * message.factor));
+
+    view.x = beforeX - (message.px - canvas.width / 2) / view.cellPixels;
+    view.y = beforeY - (message.py - canvas.height / 2) / view.cellPixels;
+  }
+
+  // Some of the maze always stays in view
+  if (maze) {
+    view.x = Math.min(maze.size, Math.max(0, view.x));
+    view.y = Math.min(maze.size, Math.max(0, view.y));
+  }
+}
+
+// Zoomed all the way out, the whole maze fits the canvas
+function minimumCellPixels() {
+  return Math.min(canvas.width, canvas.height) / maze.size;
+}
+
+function requestFrame() {
+  if (framePending) return;
+  framePending = true;
+
+  if (self.requestAnimationFrame) requestAnimationFrame(draw);
+  else setTimeout(draw, 16);
+}
+
+function scratchImage(width, height) {
+  if (scratch === null) {
+    scratch = new OffscreenCanvas(width, height);
+    scratchContext = scratch.getContext('2d');
+  }
+  if (scratch.width < width || scratch.height < height) {
+    scratch.width = Math.max(scratch.width, width);
+    scratch.height = Math.max(scratch.height, height);
+  }
+  return scratchContext.createImageData(width, height);
+}
+
+function setShade(pixels, index, shade) {
+  pixels[4 * index] = shade;
+  pixels[4 * index + 1] = shade;
+  pixels[4 * index + 2] = shade;
+  pixels[4 * index + 3] = 255;
+}
+
+function readTile(level, x0, y0, columns, rows) {
+  var pointer = Module.ccall('web_viewer_tile', 'number', ['number', 'number', 'number', 'number', 'number'],
+    [level, x0, y0, columns, rows]);
+  return Module.HEAPU8.subarray(pointer, pointer + columns * rows);
+}
+
+function draw() {
+  framePending = false;
+  if (context === null || maze === null) return;
+
+  context.fillStyle = '#3a3a3a';
+  context.fillRect(0, 0, canvas.width, canvas.height);
+
+  // Maze cell at the canvas' top left corner
+  var left = view.x - canvas.width / 2 / view.cellPixels;
+  var top = view.y - canvas.height / 2 / view.cellPixels;
+
+  if (view.cellPixels >= 2) drawCells(left, top);
+  else drawLevel(left, top);
+}
+
+// Full detail: like the animation, a cell and each of its walls take one
+// unit, so the visible cells become a (2 columns + 1) x (2 rows + 1) image
+function drawCells(left, top) {
+  var x0 = Math.floor(left);
+  var y0 = Math.floor(top);
+  var columns = Math.ceil(canvas.width / view.cellPixels) + 1;
+  var rows = Math.ceil(canvas.height / view.cellPixels) + 1;
+
+  var tile = readTile(0, x0, y0, columns, rows);
+  var width = 2 * columns + 1;
+  var height = 2 * rows + 1;
+  var image = scratchImage(width, height);
+  var pixels = image.data;
+
+  for (var i = 0; i < width * height; i++) setShade(pixels, i, WALL_SHADE);
+
+  for (var row = 0; row < rows; row++) {
+    for (var column = 0; column < columns; column++) {
+      var passages = tile[row * columns + column];
+      if (passages & MAZE_TILE_OUTSIDE) continue;
+
+      var unitX = 2 * column + 1;
+      var unitY = 2 * row + 1;
+      setShade(pixels, unitY * width + unitX, FLOOR_SHADE);
+      if (passages & PASSAGE_RIGHT) setShade(pixels, unitY * width + unitX + 1, FLOOR_SHADE);
+      if (passages & PASSAGE_BOTTOM) setShade(pixels, (unitY + 1) * width + unitX, FLOOR_SHADE);
+      if (column === 0 && (passages & PASSAGE_LEFT)) setShade(pixels, unitY * width, FLOOR_SHADE);
+      if (row === 0 && (passages & PASSAGE_TOP)) setShade(pixels, unitX, FLOOR_SHADE);
+    }
+  }
+
+  scratchContext.putImageData(image, 0, 0);
+  context.imageSmoothingEnabled = false;
+  context.drawImage(scratch, 0, 0, width, height,
+    (x0 - left) * view.cellPixels, (y0 - top) * view.cellPixels,
+    width * view.cellPixels / 2, height * view.cellPixels / 2);
+}
+
+// Zoomed out: one byte per block of 2^level x 2^level cells, the share of
+// its walls that are open, drawn as the grey the block averages to
+function drawLevel(left, top) {
+  var level = Math.min(maze.levels - 1, Math.ceil(Math.log2(1 / view.cellPixels)));
+  var block = Math.pow(2, level);
+  var blockPixels = view.cellPixels * block;
+  var levelSize = Math.ceil(maze.size / block);
+
+  var x0 = Math.floor(left / block);
+  var y0 = Math.floor(top / block);
+  var columns = Math.ceil(canvas.width / blockPixels) + 1;
+  var rows = Math.ceil(canvas.height / blockPixels) + 1;
+
+  var tile = readTile(level, x0, y0, columns, rows);
+  var image = scratchImage(columns, rows);
+  var pixels = image.data;
+
+  for (var row = 0; row < rows; row++) {
+    for (var column = 0; column < columns; column++) {
+      var x = x0 + column;
+      var y = y0 + row;
+      var shade = WALL_SHADE;
+
+      if (x >= 0 && y >= 0 && x < levelSize && y < levelSize) {
+        // A cell is four units: its floor, its right and bottom walls and a corner
+        var floor = 0.25 + 0.5 * tile[row * columns + column] / 255;
+        shade = Math.round(WALL_SHADE + (FLOOR_SHADE - WALL_SHADE) * floor);
+      }
+
+      setShade(pixels, row * columns + column, shade);
+    }
+  }
+
+  scratchContext.putImageData(image, 0, 0);
+  context.imageSmoothingEnabled = true;
+  context.drawImage(scratch, 0, 0, columns, rows,
+    (x0 * block - left) * view.cellPixels, (y0 * block - top) * view.cellPixels,
+    columns * blockPixels, rows * blockPixels);
+}
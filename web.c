@@ -24,3 +24,80 @@ int web_randomized_kruskal(int size, int direction_options)
 
     return 0;
 }
+
+static struct event_log *web_log = NULL;
+static struct event_replayer *web_replayer = NULL;
+
+int web_generate_log(int size, int direction_options)
+{
+    if (web_replayer)
+        event_replayer_free(web_replayer);
+    event_log_free(web_log);
+
+    struct rng rng;
+    rng_seed(&rng, (unsigned long long)time(NULL));
+
+    web_log = event_log_create(size, direction_options);
+
+    struct maze_walls *walls = maze_walls_create(size);
+    randomized_kruskal_walls(0, walls, direction_options, &rng, web_log);
+    maze_walls_free(walls);
+
+    web_replayer = event_replayer_create(web_log);
+
+    return web_log->total_events;
+}
+
+struct generation_event *web_log_events(void)
+{
+    return web_log->events;
+}
+
+unsigned char *web_replay_cells(void)
+{
+    return web_replayer->walls->cells;
+}
+
+int web_replay_seek(int position)
+{
+    event_replayer_seek(web_replayer, position);
+    return web_replayer->position;
+}
+
+// Viewer: the maze stays in WASM memory and the page asks for the tiles it
+// draws, so drawing cost follows the viewport, not the maze
+
+static struct maze_walls *viewer_walls = NULL;
+static struct maze_tiles *viewer_tiles = NULL;
+static unsigned char *viewer_tile = NULL;
+static size_t viewer_tile_capacity = 0;
+
+int web_viewer_generate(int size, int direction_options, int seed)
+{
+    maze_tiles_free(viewer_tiles);
+    if (viewer_walls)
+        maze_walls_free(viewer_walls);
+
+    struct rng rng;
+    rng_seed(&rng, seed ? (unsigned long long)seed : (unsigned long long)time(NULL));
+
+    viewer_walls = maze_walls_create(size);
+    randomized_kruskal_walls(0, viewer_walls, direction_options, &rng, NULL);
+    viewer_tiles = maze_tiles_create(viewer_walls);
+
+    return viewer_tiles->total_levels;
+}
+
+unsigned char *web_viewer_tile(int level, int x0, int y0, int columns, int rows)
+{
+    size_t total_bytes = (size_t)columns * rows;
+    if (total_bytes > viewer_tile_capacity)
+    {
+        free(viewer_tile);
+        viewer_tile = (unsigned char *)malloc(total_bytes);
+        viewer_tile_capacity = total_bytes;
+    }
+
+    maze_tiles_query(viewer_tiles, level, x0, y0, columns, rows, viewer_tile);
+    return viewer_tile;
+}
@@ -9,12 +9,20 @@
 #include <time.h>
 
 #include "definitions.h"
+#include "event_log.h"
+#include "maze_tiles.h"
 #include "print_maze.h"
 #include "randomized_kruskal.h"
 #include "stats.h"
 #include "util.h"
 
 extern int web_randomized_kruskal(int size, int direction_options);
+extern int web_generate_log(int size, int direction_options);
+extern struct generation_event *web_log_events(void);
+extern unsigned char *web_replay_cells(void);
+extern int web_replay_seek(int position);
+extern int web_viewer_generate(int size, int direction_options, int seed);
+extern unsigned char *web_viewer_tile(int level, int x0, int y0, int columns, int rows);
 
 #endif /* web_h */
 
@@ -0,0 +1,68 @@
+//
+//  wilson.c
+//  kruskal-maze-generation-c
+//
+//  Created by Ezzat Chamudi on 10/19/26.
+//  Copyright © 2026 Ezzat Chamudi. All rights reserved.
+//  License: Apache-2.0
+//
+
+#include "wilson.h"
+
+// Wilson's algorithm: loop-erased random walks from each cell not yet in the
+// tree until the walk hits the tree, then add the walk's path. The result is
+// a uniformly random spanning tree of the grid.
+//
+// Cost: expected total walk length is O(n log n) on a grid. The first walks
+// are the slow ones, while the tree is still small. Memory is one byte per
+// cell for the walk directions and one for tree membership; access is random.
+// Standard directions only.
+
+static const int step_dx[4] = {0, 1, 0, -1};
+static const int step_dy[4] = {-1, 0, 1, 0};
+
+void wilson_walls(struct maze_walls *walls, struct rng *rng)
+{
+    const int size = walls->size;
+    const int total_nodes = size * size;
+
+    unsigned char *in_tree = (unsigned char *)calloc(total_nodes, sizeof(unsigned char));
+    unsigned char *steps = (unsigned char *)calloc(total_nodes, sizeof(unsigned char));
+
+    in_tree[rng_range(rng, total_nodes)] = 1;
+
+    for (int start = 0; start < total_nodes; start++)
+    {
+        // Walk; revisiting a cell overwrites its step, which erases the loop
+        int node = start;
+        while (!in_tree[node])
+        {
+            int x, y, side;
+            do
+            {
+                side = rng_range(rng, 4);
+                x = node / size + step_dx[side];
+                y = node % size + step_dy[side];
+            } while (x < 0 || x >= size || y < 0 || y >= size);
+
+            steps[node] = side;
+            node = x * size + y;
+        }
+
+        // Add the loop-erased path
+        node = start;
+        while (!in_tree[node])
+        {
+            in_tree[node] = 1;
+
+            struct coordinate current = {node / size, node % size};
+            struct coordinate next = {current.x + step_dx[steps[node]], current.y + step_dy[steps[node]]};
+            maze_walls_link(walls, current, next);
+
+            node = next.x * size + next.y;
+        }
+    }
+
+    free(in_tree);
+    free(steps);
+}